@@ -1,13 +1,14 @@
 #pragma once
-#include <vector>
-#include <string>
+#include <array>
+#include <iterator>
+#include "JunoSysEx.h"
 
 struct FactoryPresetData {
     const char* name;
     unsigned char bytes[18];
 };
 
-static const FactoryPresetData junoFactoryPresets[] = {
+inline constexpr FactoryPresetData junoFactoryPresets[] = {
     {"Brass", {0x14, 0x31, 0x00, 0x66, 0x00, 0x23, 0x0D, 0x3A, 0x00, 0x56, 0x6C, 0x03, 0x31, 0x2D, 0x20, 0x00, 0x51, 0x11}},
     {"Brass Swell", {0x06, 0x30, 0x00, 0x38, 0x00, 0x2B, 0x11, 0x1A, 0x00, 0x54, 0x4B, 0x40, 0x76, 0x26, 0x25, 0x46, 0x52, 0x19}},
     {"Trumpet", {0x34, 0x2D, 0x08, 0x66, 0x00, 0x37, 0x22, 0x18, 0x01, 0x3B, 0x7F, 0x05, 0x42, 0x30, 0x10, 0x00, 0x32, 0x09}},
@@ -137,3 +138,11 @@ static const FactoryPresetData junoFactoryPresets[] = {
     {"FX", {0x4E, 0x00, 0x00, 0x00, 0x00, 0x37, 0x7F, 0x2B, 0x00, 0x7F, 0x4D, 0x00, 0x00, 0x00, 0x00, 0x7F, 0x29, 0x17}},
     {"Noise FX", {0x32, 0x00, 0x00, 0x2D, 0x00, 0x26, 0x54, 0x20, 0x00, 0x7F, 0x65, 0x00, 0x31, 0x37, 0x00, 0x38, 0x39, 0x19}}
 };
+
+// Decoded at compile time with the SysEx patch layout; no work at startup
+inline constexpr auto junoFactoryPatches = [] {
+    std::array<JunoSysEx::PatchValues, std::size(junoFactoryPresets)> patches {};
+    for (size_t i = 0; i < patches.size(); ++i)
+        patches[i] = JunoSysEx::decodePatch(junoFactoryPresets[i].bytes);
+    return patches;
+}();
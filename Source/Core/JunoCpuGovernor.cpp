@@ -0,0 +1,104 @@
+#include "JunoCpuGovernor.h"
+#include <cmath>
+
+void JunoCpuGovernor::prepare(double sr) {
+    sampleRate = sr;
+    reset();
+}
+
+void JunoCpuGovernor::reset() {
+    smoothedLoad = 0.0;
+    timeAbove = 0.0;
+    timeBelow = 0.0;
+    timeSinceChange = 0.0;
+    overruns = 0;
+    leftLoad.fill(0.0);
+    settledLoad.fill(0.0);
+    tier.store(Full, std::memory_order_relaxed);
+}
+
+void JunoCpuGovernor::setTier(int newTier) {
+    newTier = juce::jlimit(0, NumTiers - 1, newTier);
+    const int current = getTier();
+    if (newTier > current) leftLoad[(size_t)current] = smoothedLoad;
+    
+    tier.store(newTier, std::memory_order_relaxed);
+    settledLoad[(size_t)newTier] = 0.0;   // Measured again once it has settled
+    timeAbove = 0.0;
+    timeBelow = 0.0;
+    timeSinceChange = 0.0;
+    overruns = 0;
+}
+
+double JunoCpuGovernor::predictLoad(int targetTier) const {
+    const double before = leftLoad[(size_t)targetTier];
+    const double settled = settledLoad[(size_t)getTier()];
+    if (before <= 0.0) return smoothedLoad;   // Never measured there
+    
+    // The load at the target tier, scaled by how the work changed since (voices, settings)
+    return settled > 0.0 ? before * smoothedLoad / settled : before;
+}
+
+void JunoCpuGovernor::update(double renderSeconds, int numSamples) {
+    if (numSamples <= 0 || sampleRate <= 0.0) return;
+    
+    const double budget = numSamples / sampleRate;
+    const double load = renderSeconds / budget;
+    
+    // Smoothed load (time-based, independent of the block size)
+    smoothedLoad += (load - smoothedLoad) * (1.0 - std::exp(-budget / kLoadSmoothing));
+    
+    const int current = getTier();
+    timeSinceChange += budget;
+    
+    // Missed the deadline several blocks in a row: step down at once
+    overruns = load >= 1.0 ? overruns + 1 : 0;
+    if (overruns >= kOverrunBlocks && current < NumTiers - 1) {
+        smoothedLoad = juce::jmax(smoothedLoad, load);
+        setTier(current + 1);
+        return;
+    }
+    
+    // Let the smoothed load settle on the new tier before acting on it
+    if (timeSinceChange < kMinHold) return;
+    if (settledLoad[(size_t)current] <= 0.0) settledLoad[(size_t)current] = juce::jmax(smoothedLoad, 1.0e-6);
+    
+    if (smoothedLoad > kHighLoad) {
+        timeBelow = 0.0;
+        timeAbove += budget;
+        if (timeAbove >= kStepDownHold && current < NumTiers - 1)
+            setTier(current + 1);
+    } else if (smoothedLoad < kLowLoad) {
+        timeAbove = 0.0;
+        timeBelow += budget;
+        if (timeBelow >= kStepUpHold && current > Full && predictLoad(current - 1) < kStepUpTarget)
+            setTier(current - 1);
+    } else {
+        timeAbove = 0.0;
+        timeBelow = 0.0;
+    }
+}
+
+int JunoCpuGovernor::limitOversampling(int factor) const {
+    const int current = getTier();
+    if (current >= NoOversampling) return 1;
+    if (current >= ReducedOversampling) return juce::jmax(1, factor / 2);
+    return factor;
+}
+
+int JunoCpuGovernor::limitControlRate(int milliseconds) const {
+    if (getTier() >= ControlRate) return juce::jmax(2, milliseconds);
+    return milliseconds;
+}
+
+const char* JunoCpuGovernor::getTierName(int t) {
+    switch (t) {
+        case Full:                return "FULL";
+        case ReducedOversampling: return "OS -1";
+        case NoOversampling:      return "OS 1x";
+        case ControlRate:         return "CTRL 2ms";
+        case ChorusEconomy:       return "CHORUS ECO";
+        case TailCulling:         return "TAIL CULL";
+        default:                  return "";
+    }
+}
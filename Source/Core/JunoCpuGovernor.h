@@ -0,0 +1,85 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+/**
+ * JunoCpuGovernor - Keeps the engine inside its realtime budget
+ * 
+ * Measures each block's render time against the block duration. When the
+ * load approaches the deadline it steps down a degradation ladder, and
+ * steps back up once headroom has been stable for a while and the load
+ * predicted for the higher tier fits the budget:
+ * 
+ *   0 FULL         - everything as set on the panel
+ *   1 OS -1        - oversampling one tier lower
+ *   2 OS 1x        - no oversampling
+ *   3 CTRL 2ms     - ADSR/LFO at a 2 ms control tick (at least)
+ *   4 CHORUS ECO   - chorus processed once (mono) and copied to both sides
+ *   5 TAIL CULL    - quiet release tails are ended early
+ * 
+ * Hysteresis: the load measured at a tier is stored when stepping down from
+ * it, and scaled by how the load has changed since, to predict a step up
+ * (an oversampling tier costs 2-4x, so "low load now" alone would bounce).
+ * Every change is held for kMinHold, and a missed deadline only steps down
+ * at once after kOverrunBlocks consecutive overruns (one outlier block from
+ * a page fault is ignored).
+ * 
+ * Offline renders are never degraded (reset() and skip update()).
+ * The tier is atomic so the UI can read it.
+ */
+class JunoCpuGovernor {
+public:
+    enum Tier {
+        Full = 0,
+        ReducedOversampling,
+        NoOversampling,
+        ControlRate,
+        ChorusEconomy,
+        TailCulling,
+        NumTiers
+    };
+    
+    void prepare(double sampleRate);
+    void reset();
+    
+    // Measured render time (seconds) of a block of numSamples
+    void update(double renderSeconds, int numSamples);
+    
+    int getTier() const { return tier.load(std::memory_order_relaxed); }
+    double getLoad() const { return smoothedLoad; }
+    static const char* getTierName(int tier);
+    
+    // Limits applied by the processor
+    int limitOversampling(int factor) const;
+    int limitControlRate(int milliseconds) const;
+    bool useChorusEconomy() const { return getTier() >= ChorusEconomy; }
+    bool useTailCulling() const { return getTier() >= TailCulling; }
+    
+private:
+    static constexpr double kHighLoad = 0.70;        // Of the block budget
+    static constexpr double kLowLoad = 0.35;
+    static constexpr double kStepDownHold = 0.05;    // Seconds above kHighLoad
+    static constexpr double kStepUpHold = 2.0;       // Seconds below kLowLoad
+    static constexpr double kLoadSmoothing = 0.1;    // Seconds
+    static constexpr double kMinHold = 0.5;          // Seconds after any change
+    static constexpr double kStepUpTarget = 0.55;    // Predicted load allowed after a step up
+    static constexpr int kOverrunBlocks = 3;         // Consecutive missed deadlines
+    
+    double sampleRate = 44100.0;
+    double smoothedLoad = 0.0;
+    double timeAbove = 0.0;
+    double timeBelow = 0.0;
+    double timeSinceChange = 0.0;
+    int overruns = 0;
+    std::atomic<int> tier { Full };
+    
+    // Per tier: load when it was left downwards, and the settled load after entering it
+    std::array<double, NumTiers> leftLoad {};
+    std::array<double, NumTiers> settledLoad {};
+    
+    double predictLoad(int targetTier) const;
+    
+    void setTier(int newTier);
+};
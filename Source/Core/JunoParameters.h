@@ -0,0 +1,123 @@
+#pragma once
+
+#include <array>
+#include <cstring>
+
+/**
+ * JunoParameters - Parameter schema for SimpleJuno106 (single source of truth)
+ *
+ * One constexpr table drives the APVTS layout, SynthParams, SysEx (in/out),
+ * tape/factory patch decoding and presets. Code addresses parameters by
+ * Index (O(1) array access); the string ID is only used where JUCE or a
+ * stored file needs it.
+ *
+ * ORDER:
+ * - The 16 sliders come first, in Juno-106 patch byte order, so their Index
+ *   is the SysEx parameter number (0x00-0x0F)
+ * - Then the SW1/SW2 switches: the first NumPatchParams entries are exactly
+ *   what an 18-byte patch stores (see JunoSysEx for the bit layout)
+ * - Then performance and engine parameters (not part of a patch)
+ *
+ * Limits that mirror engine constants (voices, parts, render threads) are
+ * checked against them where the engine is visible (PluginProcessor.cpp).
+ */
+namespace JunoParams
+{
+    enum Index
+    {
+        // Patch sliders (SysEx 0x00-0x0F)
+        LfoRate, LfoDelay, LfoToDCO, Pwm, Noise,
+        VcfFreq, Resonance, EnvAmount, LfoToVCF, KybdTracking,
+        VcaLevel, Attack, Decay, Sustain, Release, SubOsc,
+
+        // Patch switches (SW1, SW2)
+        DcoRange, PulseOn, SawOn, Chorus1, Chorus2,
+        PwmMode, VcfPolarity, VcaMode, HpfFreq,
+
+        // Performance
+        PolyMode, PortamentoTime, PortamentoOn,
+        Bender, BenderToDCO, BenderToVCF, BenderToLFO,
+
+        // Multitimbral / engine
+        Voices, Parts, PartReserve,
+        Tune, Drift, OutputDrive,
+        CtrlRate, Oversampling, OfflineMaxQuality, CpuGovernor, TailFloor, RenderThreads,
+        MidiOut,
+
+        NumParams
+    };
+
+    static constexpr int NumPatchSliders = SubOsc + 1;
+    static constexpr int NumPatchParams = HpfFreq + 1;
+
+    enum class Type { Float, Int, Bool };
+
+    struct Spec
+    {
+        const char* id;
+        const char* name;
+        Type type;
+        float min, max, def;
+    };
+
+    inline constexpr std::array<Spec, NumParams> kSpecs {{
+        { "lfoRate",           "LFO Rate",                   Type::Float, 0.0f, 1.0f, 0.5f },
+        { "lfoDelay",          "LFO Delay",                  Type::Float, 0.0f, 1.0f, 0.0f },
+        { "lfoToDCO",          "LFO to DCO",                 Type::Float, 0.0f, 1.0f, 0.0f },
+        { "pwm",               "PWM Level",                  Type::Float, 0.0f, 1.0f, 0.0f },
+        { "noise",             "Noise Level",                Type::Float, 0.0f, 1.0f, 0.0f },
+        { "vcfFreq",           "VCF Freq",                   Type::Float, 0.0f, 1.0f, 1.0f },
+        { "resonance",         "Resonance",                  Type::Float, 0.0f, 1.0f, 0.0f },
+        { "envAmount",         "Env Amount",                 Type::Float, 0.0f, 1.0f, 0.0f },
+        { "lfoToVCF",          "LFO to VCF",                 Type::Float, 0.0f, 1.0f, 0.0f },
+        { "kybdTracking",      "VCF Kykd Track",             Type::Float, 0.0f, 1.0f, 0.0f },
+        { "vcaLevel",          "VCA Level",                  Type::Float, 0.0f, 1.0f, 1.0f },
+        { "attack",            "Attack",                     Type::Float, 0.0f, 1.0f, 0.0f },
+        { "decay",             "Decay",                      Type::Float, 0.0f, 1.0f, 0.0f },
+        { "sustain",           "Sustain",                    Type::Float, 0.0f, 1.0f, 1.0f },
+        { "release",           "Release",                    Type::Float, 0.0f, 1.0f, 0.0f },
+        { "subOsc",            "Sub Osc Level",              Type::Float, 0.0f, 1.0f, 0.0f },
+
+        { "dcoRange",          "DCO Range",                  Type::Int,   0.0f, 2.0f, 1.0f },
+        { "pulseOn",           "DCO Pulse",                  Type::Bool,  0.0f, 1.0f, 0.0f },
+        { "sawOn",             "DCO Saw",                    Type::Bool,  0.0f, 1.0f, 1.0f },
+        { "chorus1",           "Chorus I",                   Type::Bool,  0.0f, 1.0f, 0.0f },
+        { "chorus2",           "Chorus II",                  Type::Bool,  0.0f, 1.0f, 0.0f },
+        { "pwmMode",           "PWM Mode",                   Type::Int,   0.0f, 1.0f, 0.0f },
+        { "vcfPolarity",       "VCF Polarity",               Type::Int,   0.0f, 1.0f, 0.0f },
+        { "vcaMode",           "VCA Mode",                   Type::Int,   0.0f, 1.0f, 0.0f },
+        { "hpfFreq",           "HPF Freq",                   Type::Int,   0.0f, 3.0f, 0.0f },
+
+        { "polyMode",          "Poly Mode",                  Type::Int,   1.0f, 3.0f, 1.0f },
+        { "portamentoTime",    "Portamento Time",            Type::Float, 0.0f, 1.0f, 0.0f },
+        { "portamentoOn",      "Portamento On",              Type::Bool,  0.0f, 1.0f, 0.0f },
+        { "bender",            "Bender",                     Type::Float, -1.0f, 1.0f, 0.0f },
+        { "benderToDCO",       "Bender to DCO",              Type::Float, 0.0f, 1.0f, 0.0f },
+        { "benderToVCF",       "Bender to VCF",              Type::Float, 0.0f, 1.0f, 0.0f },
+        { "benderToLFO",       "Bender to LFO",              Type::Float, 0.0f, 1.0f, 0.0f },
+
+        { "voices",            "Voices",                     Type::Int,   1.0f, 32.0f, 6.0f },
+        { "parts",             "Multitimbral Parts",         Type::Int,   1.0f, 4.0f, 1.0f },
+        { "partReserve",       "Voices Reserved per Part",   Type::Int,   0.0f, 8.0f, 0.0f },
+        { "tune",              "Master Tune",                Type::Float, -50.0f, 50.0f, 0.0f },
+        { "drift",             "Analog Drift",               Type::Float, 0.0f, 1.0f, 0.0f },
+        { "outputDrive",       "Output Stage Drive",         Type::Float, 0.0f, 1.0f, 0.0f },
+        { "ctrlRate",          "Control Rate (ms)",          Type::Int,   0.0f, 4.0f, 0.0f },
+        { "oversampling",      "Oversampling (1x/2x/4x)",    Type::Int,   0.0f, 2.0f, 0.0f },
+        { "offlineMaxQuality", "Offline Render Max Quality", Type::Bool,  0.0f, 1.0f, 1.0f },
+        { "cpuGovernor",       "CPU Governor",               Type::Bool,  0.0f, 1.0f, 1.0f },
+        { "tailFloor",         "Tail Cull Floor (dBFS)",     Type::Float, -120.0f, -48.0f, -96.0f },
+        { "renderThreads",     "Render Threads",             Type::Int,   0.0f, 15.0f, 0.0f },
+        { "midiOut",           "MIDI Out Enabled",           Type::Bool,  0.0f, 1.0f, 0.0f }
+    }};
+
+    inline constexpr const char* getID(Index index) { return kSpecs[(size_t)index].id; }
+
+    /** Index for a parameter ID (stored files, MIDI learn), -1 if unknown */
+    inline int findIndex(const char* id)
+    {
+        for (int i = 0; i < NumParams; ++i)
+            if (std::strcmp(kSpecs[(size_t)i].id, id) == 0) return i;
+        return -1;
+    }
+}
@@ -0,0 +1,106 @@
+#include "JunoRenderPool.h"
+#include <thread>
+
+JunoRenderPool::~JunoRenderPool() {
+    stop();
+}
+
+void JunoRenderPool::start(int numWorkers) {
+    numWorkers = juce::jlimit(0, kMaxWorkers, numWorkers);
+    if (numWorkers == workers.size()) return;
+
+    stop();
+    for (int i = 0; i < numWorkers; ++i) {
+        auto* worker = workers.add(new Worker(*this, i));
+        worker->startThread(juce::Thread::Priority::highest);
+    }
+}
+
+void JunoRenderPool::stop() {
+    for (auto* worker : workers) {
+        worker->signalThreadShouldExit();
+        worker->wakeEvent.signal();
+    }
+    for (auto* worker : workers) {
+        worker->stopThread(1000);
+    }
+    workers.clear();
+}
+
+void JunoRenderPool::run(int numTasks, TaskFunction task, void* context) {
+    if (numTasks <= 0) return;
+
+    // No workers (or a single task): nothing to share
+    if (workers.isEmpty() || numTasks == 1) {
+        for (int i = 0; i < numTasks; ++i) task(context, i);
+        return;
+    }
+
+    jassert(numTasks <= kMaxTasks);
+    numTasks = juce::jmin(numTasks, kMaxTasks);
+
+    taskFunction = task;
+    taskContext = context;
+    pendingTasks.store(numTasks, std::memory_order_relaxed);
+    const uint32_t batch = ++batchCounter;
+    batchState.store(pack(batch, numTasks), std::memory_order_seq_cst);
+
+    // Wake only the workers that stopped spinning
+    for (auto* worker : workers) {
+        if (worker->sleeping.load(std::memory_order_seq_cst)) {
+            worker->wakeEvent.signal();
+        }
+    }
+
+    // The audio thread takes its share too
+    while (runNextTask(batch)) {}
+
+    // Join: the remaining tasks are already running on workers
+    while (pendingTasks.load(std::memory_order_acquire) > 0) {
+        std::this_thread::yield();
+    }
+}
+
+bool JunoRenderPool::runNextTask(uint32_t batch) {
+    uint64_t state = batchState.load(std::memory_order_acquire);
+    do {
+        if (batchOf(state) != batch || indexOf(state) >= countOf(state)) return false;
+    } while (!batchState.compare_exchange_weak(state, state + 1, std::memory_order_acq_rel, std::memory_order_acquire));
+
+    taskFunction(taskContext, indexOf(state));
+    pendingTasks.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+//==============================================================================
+JunoRenderPool::Worker::Worker(JunoRenderPool& p, int index)
+    : juce::Thread("Juno Voice Worker " + juce::String(index + 1)), pool(p) {}
+
+void JunoRenderPool::Worker::run() {
+    uint32_t seenGeneration = batchOf(pool.batchState.load(std::memory_order_acquire));
+
+    while (!threadShouldExit()) {
+        // Spin for a new batch
+        int spins = 0;
+        uint32_t current = batchOf(pool.batchState.load(std::memory_order_acquire));
+        while (current == seenGeneration && spins < kSpinIterations && !threadShouldExit()) {
+            std::this_thread::yield();
+            current = batchOf(pool.batchState.load(std::memory_order_acquire));
+            ++spins;
+        }
+
+        if (current == seenGeneration) {
+            // Nothing arrived: sleep until run() signals (re-check after
+            // publishing the flag so a batch started in between is not missed)
+            sleeping.store(true, std::memory_order_seq_cst);
+            if (batchOf(pool.batchState.load(std::memory_order_seq_cst)) == seenGeneration && !threadShouldExit()) {
+                wakeEvent.wait(-1);
+            }
+            sleeping.store(false, std::memory_order_seq_cst);
+            continue;
+        }
+
+        seenGeneration = current;
+        while (pool.runNextTask(seenGeneration)) {}
+    }
+}
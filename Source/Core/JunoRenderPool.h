@@ -0,0 +1,78 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+
+/**
+ * JunoRenderPool - Realtime worker pool for parallel voice rendering
+ *
+ * The audio thread hands out a batch of independent tasks (voice groups);
+ * it works on the batch itself together with the workers and returns once
+ * every task is done.
+ *
+ * REALTIME RULES:
+ * - No locks or allocation in run(): tasks are claimed with a CAS on one
+ *   64-bit word {generation, count, next index}, so a worker still looking
+ *   at a finished batch can never claim an index of the next one; the join
+ *   is a spin on an atomic count
+ * - Workers spin briefly after each batch (the next block is usually close)
+ *   and then sleep on their own event; run() only signals sleeping workers
+ * - start()/stop() create and destroy threads: message thread only
+ *   (prepareToPlay / destructor), never while run() is executing
+ */
+class JunoRenderPool {
+public:
+    using TaskFunction = void (*)(void* context, int taskIndex);
+
+    static constexpr int kMaxWorkers = 15;
+
+    JunoRenderPool() = default;
+    ~JunoRenderPool();
+
+    void start(int numWorkers);
+    void stop();
+    int getNumWorkers() const { return workers.size(); }
+
+    // Runs task(context, 0 .. numTasks-1) on the calling thread and the
+    // workers; returns when all of them have finished
+    void run(int numTasks, TaskFunction task, void* context);
+
+private:
+    class Worker : public juce::Thread {
+    public:
+        Worker(JunoRenderPool& p, int index);
+        void run() override;
+
+        juce::WaitableEvent wakeEvent;
+        std::atomic<bool> sleeping { false };
+
+    private:
+        JunoRenderPool& pool;
+    };
+
+    // Claims and runs one task of batch `batch`; false when that batch is
+    // exhausted or has been replaced
+    bool runNextTask(uint32_t batch);
+
+    static constexpr int kSpinIterations = 4000;
+
+    juce::OwnedArray<Worker> workers;
+
+    // Batch word: generation (32) | task count (16) | next index (16)
+    static constexpr int kMaxTasks = 0xFFFF;
+    static constexpr uint64_t pack(uint32_t batch, int count) { return ((uint64_t)batch << 32) | ((uint64_t)count << 16); }
+    static constexpr uint32_t batchOf(uint64_t state) { return (uint32_t)(state >> 32); }
+    static constexpr int countOf(uint64_t state) { return (int)((state >> 16) & 0xFFFF); }
+    static constexpr int indexOf(uint64_t state) { return (int)(state & 0xFFFF); }
+
+    // Current batch: written by run() before the batch word is published and
+    // only read after a successful claim (the batch cannot end before that task)
+    TaskFunction taskFunction = nullptr;
+    void* taskContext = nullptr;
+    uint32_t batchCounter = 0;   // run() only
+
+    std::atomic<uint64_t> batchState { 0 };
+    std::atomic<int> pendingTasks { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE(JunoRenderPool)
+};
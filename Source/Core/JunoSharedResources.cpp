@@ -0,0 +1,63 @@
+// Source/Core/JunoSharedResources.cpp
+#include "JunoSharedResources.h"
+#include "FactoryPresets.h"
+
+JunoSharedResources::JunoSharedResources() {
+    factoryBank.name = "Factory Bank";
+    // Values were decoded at compile time: no ValueTrees are built here
+    for (size_t i = 0; i < junoFactoryPatches.size(); ++i) {
+        factoryBank.patches.emplace_back(junoFactoryPresets[i].name, "Factory", junoFactoryPatches[i]);
+    }
+    
+    userBank.name = "User Bank";
+    scanUserPresets();
+}
+
+void JunoSharedResources::scanUserPresets() {
+    auto userDir = getUserPresetsDirectory();
+    if (!userDir.exists()) return;
+    auto files = userDir.findChildFiles(juce::File::findFiles, false, "*.json");
+    for (const auto& file : files) {
+        auto json = juce::JSON::parse(file);
+        if (json.isObject()) {
+            auto obj = json.getDynamicObject();
+            if (obj != nullptr) {
+                juce::String name = obj->getProperty("name").toString();
+                auto stateVar = obj->getProperty("state");
+                if (stateVar.isObject()) {
+                    juce::ValueTree state = juce::ValueTree::fromXml(stateVar.toString());
+                    if (state.isValid()) userBank.patches.push_back(PresetManager::Preset(name, "User", state));
+                }
+            }
+        }
+    }
+}
+
+PresetManager::Bank JunoSharedResources::getUserBank() const {
+    const juce::ScopedLock sl(userLock);
+    return userBank;
+}
+
+void JunoSharedResources::setUserPreset(const PresetManager::Preset& preset) {
+    const juce::ScopedLock sl(userLock);
+    for (auto& p : userBank.patches) {
+        if (p.name == preset.name) {
+            p = preset;
+            return;
+        }
+    }
+    userBank.patches.push_back(preset);
+}
+
+void JunoSharedResources::removeUserPreset(const juce::String& name) {
+    const juce::ScopedLock sl(userLock);
+    auto& patches = userBank.patches;
+    patches.erase(std::remove_if(patches.begin(), patches.end(),
+                                 [&name](const PresetManager::Preset& p) { return p.name == name; }),
+                  patches.end());
+}
+
+juce::File JunoSharedResources::getUserPresetsDirectory() {
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("SimpleJuno106v2").getChildFile("UserPresets");
+}
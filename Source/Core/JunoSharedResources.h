@@ -0,0 +1,45 @@
+// Source/Core/JunoSharedResources.h
+#pragma once
+
+#include <JuceHeader.h>
+#include "PresetManager.h"
+
+/**
+ * JunoSharedResources - Data shared by every plugin instance in the process
+ *
+ * Held through juce::SharedResourcePointer: the first instance builds it,
+ * later ones only take a reference, and it is freed with the last one.
+ *
+ * - Factory bank: junoFactoryPresets decoded once (immutable)
+ * - User library index: the user preset directory scanned once; saves and
+ *   deletes from any instance keep it current for the next ones
+ *
+ * Presets are handed out by copy, which only shares their ValueTrees
+ * (reference counted): nothing is decoded or rescanned per instance.
+ *
+ * The DSP tables (DCO wavetables, oversampler half-band designs) need
+ * nothing from the host or the file system, so they are process-wide
+ * statics built on first use (JunoWavetables::get(), JunoOversampler).
+ */
+class JunoSharedResources {
+public:
+    JunoSharedResources();
+    
+    const PresetManager::Bank& getFactoryBank() const { return factoryBank; }
+    
+    // User library (thread safe)
+    PresetManager::Bank getUserBank() const;
+    void setUserPreset(const PresetManager::Preset& preset);   // Adds, or replaces by name
+    void removeUserPreset(const juce::String& name);
+    
+    static juce::File getUserPresetsDirectory();
+    
+private:
+    PresetManager::Bank factoryBank;
+    PresetManager::Bank userBank;
+    mutable juce::CriticalSection userLock;
+    
+    void scanUserPresets();
+    
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(JunoSharedResources)
+};
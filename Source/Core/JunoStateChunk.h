@@ -0,0 +1,187 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <cstring>
+#include "JunoParameters.h"
+
+/**
+ * JunoStateChunk - Versioned binary plugin state
+ *
+ * Layout (little-endian):
+ *   "J106" | uint16 version | uint16 reserved | sections... (to the end)
+ *   section = uint32 tag | uint32 size | payload
+ *
+ * COMPATIBILITY:
+ * - Readers skip sections they do not know and ignore trailing bytes inside
+ *   a known one: newer chunks load in older builds (forward) as long as
+ *   sections only grow at the end
+ * - Sections missing from older chunks keep their defaults (backward);
+ *   version-specific fix-ups go in the processor's setStateInformation
+ * - Parameters are stored as one float array in schema order plus a digest
+ *   of the schema IDs. A matching digest restores with a single memcpy; any
+ *   other schema is migrated through the ParameterIDs section
+ * - Anything without the magic is handed to the XML fallback (old sessions)
+ */
+namespace JunoStateChunk
+{
+    static constexpr int kVersion = 1;
+    static constexpr char kMagic[4] = { 'J', '1', '0', '6' };
+    static constexpr int kHeaderSize = 8;
+    static constexpr int kMaxSections = 16;
+
+    constexpr juce::uint32 makeTag(char a, char b, char c, char d)
+    {
+        return (juce::uint32)(uint8_t)a | ((juce::uint32)(uint8_t)b << 8)
+             | ((juce::uint32)(uint8_t)c << 16) | ((juce::uint32)(uint8_t)d << 24);
+    }
+
+    enum SectionTag : juce::uint32
+    {
+        Parameters   = makeTag('P', 'R', 'M', 'S'),  // uint32 digest | uint16 count | float[count]
+        ParameterIDs = makeTag('P', 'I', 'D', 'S'),  // count x UTF-8 string (schema order of the writer)
+        MidiMappings = makeTag('M', 'I', 'D', 'I'),  // MidiLearnHandler::writeMappings
+        PresetRef    = makeTag('P', 'R', 'S', 'T'),  // bank name | int bank | int preset
+        Parts        = makeTag('P', 'A', 'R', 'T')   // per part 1..n: byte stored | float[NumPatchParams]
+    };
+
+    /** FNV-1a over the parameter IDs in schema order */
+    constexpr juce::uint32 computeSchemaDigest()
+    {
+        juce::uint32 hash = 2166136261u;
+        for (const auto& spec : JunoParams::kSpecs)
+        {
+            for (const char* c = spec.id; *c != 0; ++c)
+                hash = (hash ^ (uint8_t)*c) * 16777619u;
+            hash = (hash ^ 0xFFu) * 16777619u;   // Separator
+        }
+        return hash;
+    }
+    static constexpr juce::uint32 kSchemaDigest = computeSchemaDigest();
+
+    //==============================================================================
+    class Writer
+    {
+    public:
+        explicit Writer(juce::MemoryBlock& dest) : out(dest, false)
+        {
+            out.write(kMagic, sizeof(kMagic));
+            out.writeShort((short)kVersion);
+            out.writeShort(0);   // Reserved
+        }
+
+        /** Appends a section; fill(juce::OutputStream&) writes its payload */
+        template <typename Fill>
+        void addSection(SectionTag tag, Fill&& fill)
+        {
+            payload.reset();
+            fill(payload);
+            out.writeInt((int)tag);
+            out.writeInt((int)payload.getDataSize());
+            out.write(payload.getData(), payload.getDataSize());
+        }
+
+    private:
+        juce::MemoryOutputStream out;
+        juce::MemoryOutputStream payload;
+    };
+
+    //==============================================================================
+    struct Section
+    {
+        juce::uint32 tag = 0;
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+    };
+
+    /** Indexes the sections of a chunk in place (no copies) */
+    class Reader
+    {
+    public:
+        static bool isChunk(const void* data, int size)
+        {
+            return data != nullptr && size >= kHeaderSize && std::memcmp(data, kMagic, sizeof(kMagic)) == 0;
+        }
+
+        bool parse(const void* data, int size)
+        {
+            if (!isChunk(data, size)) return false;
+
+            auto* bytes = static_cast<const uint8_t*>(data);
+            version = juce::ByteOrder::littleEndianShort(bytes + 4);
+
+            size_t pos = kHeaderSize;
+            numSections = 0;
+            while (pos + 8 <= (size_t)size)
+            {
+                const auto tag = juce::ByteOrder::littleEndianInt(bytes + pos);
+                const size_t length = juce::ByteOrder::littleEndianInt(bytes + pos + 4);
+                pos += 8;
+                if (length > (size_t)size - pos) return false;   // Truncated
+
+                if (numSections < kMaxSections)
+                    sections[(size_t)numSections++] = { tag, bytes + pos, length };
+                pos += length;
+            }
+            return true;
+        }
+
+        int getVersion() const { return version; }
+
+        const Section* find(SectionTag tag) const
+        {
+            for (int i = 0; i < numSections; ++i)
+                if (sections[(size_t)i].tag == (juce::uint32)tag) return &sections[(size_t)i];
+            return nullptr;
+        }
+
+        /** Parameter values in schema order; false if the chunk has none */
+        bool readParameters(std::array<float, JunoParams::NumParams>& values) const
+        {
+            const auto* params = find(Parameters);
+            if (params == nullptr || params->size < 6) return false;
+
+            const auto digest = juce::ByteOrder::littleEndianInt(params->data);
+            const size_t count = juce::ByteOrder::littleEndianShort(params->data + 4);
+            if (params->size < 6 + count * sizeof(float)) return false;
+            const uint8_t* floats = params->data + 6;
+
+            // Same schema: the block is the parameter array
+            if (digest == kSchemaDigest && count == (size_t)JunoParams::NumParams)
+            {
+               #if JUCE_LITTLE_ENDIAN
+                std::memcpy(values.data(), floats, sizeof(float) * values.size());
+               #else
+                for (size_t i = 0; i < values.size(); ++i) {
+                    const auto bits = juce::ByteOrder::littleEndianInt(floats + i * sizeof(float));
+                    std::memcpy(&values[i], &bits, sizeof(float));
+                }
+               #endif
+                return true;
+            }
+
+            // Other schema (older or newer build): match by ID, defaults for the rest
+            const auto* ids = find(ParameterIDs);
+            if (ids == nullptr) return false;
+
+            for (size_t i = 0; i < values.size(); ++i)
+                values[i] = JunoParams::kSpecs[i].def;
+
+            juce::MemoryInputStream in(ids->data, ids->size, false);
+            for (size_t i = 0; i < count && !in.isExhausted(); ++i)
+            {
+                const auto id = in.readString();
+                const int index = JunoParams::findIndex(id.toRawUTF8());
+                if (index < 0) continue;
+
+                const auto bits = juce::ByteOrder::littleEndianInt(floats + i * sizeof(float));
+                std::memcpy(&values[(size_t)index], &bits, sizeof(float));
+            }
+            return true;
+        }
+
+    private:
+        std::array<Section, kMaxSections> sections {};
+        int numSections = 0;
+        int version = 0;
+    };
+}
@@ -1,6 +1,8 @@
 #pragma once
 #include <JuceHeader.h>
+#include <array>
 #include <vector>
+#include "JunoParameters.h"
 
 /**
  * JunoSysEx - Helper for Roland Juno-106 SysEx protocol
@@ -38,6 +40,106 @@ namespace JunoSysEx
         SWITCHES_2 = 0x11
     };
 
+    // Switch bytes of a patch (dump, tape or factory table)
+    namespace SW1
+    {
+        static constexpr uint8_t kRange16   = 1 << 0;
+        static constexpr uint8_t kRange8    = 1 << 1;
+        static constexpr uint8_t kRange4    = 1 << 2;
+        static constexpr uint8_t kPulse     = 1 << 3;
+        static constexpr uint8_t kSaw       = 1 << 4;
+        static constexpr uint8_t kChorusOff = 1 << 5;   // 0 = chorus on
+        static constexpr uint8_t kChorusI   = 1 << 6;   // 1 = I, 0 = II
+    }
+    namespace SW2
+    {
+        static constexpr uint8_t kPwmMode     = 1 << 0;
+        static constexpr uint8_t kVcfPolarity = 1 << 1;
+        static constexpr uint8_t kVcaGate     = 1 << 2;
+        static constexpr int kHpfShift = 3;             // Bits 3-4
+        static constexpr uint8_t kHpfMask = 0x03;
+    }
+
+    //==============================================================================
+    // A decoded 18-byte patch: the first NumPatchParams parameters of the
+    // schema, in parameter units (sliders 0-1, switches 0/1, range 0-2, HPF 0-3)
+    using PatchValues = std::array<float, JunoParams::NumPatchParams>;
+
+    static_assert(static_cast<int>(JunoParams::LfoRate) == static_cast<int>(LFO_RATE)
+                  && static_cast<int>(JunoParams::SubOsc) == static_cast<int>(DCO_SUB)
+                  && JunoParams::NumPatchSliders == static_cast<int>(SWITCHES_1),
+                  "Patch sliders must follow the SysEx parameter numbers");
+
+    constexpr void decodeSwitches1(uint8_t sw1, PatchValues& v)
+    {
+        using namespace JunoParams;
+        v[DcoRange] = (sw1 & SW1::kRange16) ? 0.0f : ((sw1 & SW1::kRange8) ? 1.0f : ((sw1 & SW1::kRange4) ? 2.0f : 1.0f));
+        v[PulseOn] = (sw1 & SW1::kPulse) ? 1.0f : 0.0f;
+        v[SawOn] = (sw1 & SW1::kSaw) ? 1.0f : 0.0f;
+        const bool chorusOn = (sw1 & SW1::kChorusOff) == 0;
+        v[Chorus1] = chorusOn && (sw1 & SW1::kChorusI) ? 1.0f : 0.0f;
+        v[Chorus2] = chorusOn && !(sw1 & SW1::kChorusI) ? 1.0f : 0.0f;
+    }
+
+    constexpr void decodeSwitches2(uint8_t sw2, PatchValues& v)
+    {
+        using namespace JunoParams;
+        v[PwmMode] = (sw2 & SW2::kPwmMode) ? 1.0f : 0.0f;
+        v[VcfPolarity] = (sw2 & SW2::kVcfPolarity) ? 1.0f : 0.0f;
+        v[VcaMode] = (sw2 & SW2::kVcaGate) ? 1.0f : 0.0f;
+        v[HpfFreq] = static_cast<float>((sw2 >> SW2::kHpfShift) & SW2::kHpfMask);
+    }
+
+    constexpr uint8_t encodeSwitches1(const PatchValues& v)
+    {
+        using namespace JunoParams;
+        const int range = static_cast<int>(v[DcoRange]);
+        uint8_t sw1 = range == 0 ? SW1::kRange16 : (range == 2 ? SW1::kRange4 : SW1::kRange8);
+        if (v[PulseOn] > 0.5f) sw1 |= SW1::kPulse;
+        if (v[SawOn] > 0.5f) sw1 |= SW1::kSaw;
+        // The hardware has no I+II in a patch: I wins
+        if (v[Chorus1] > 0.5f) sw1 |= SW1::kChorusI;
+        else if (v[Chorus2] <= 0.5f) sw1 |= SW1::kChorusOff;
+        return sw1;
+    }
+
+    constexpr uint8_t encodeSwitches2(const PatchValues& v)
+    {
+        using namespace JunoParams;
+        uint8_t sw2 = 0;
+        if (v[PwmMode] > 0.5f) sw2 |= SW2::kPwmMode;
+        if (v[VcfPolarity] > 0.5f) sw2 |= SW2::kVcfPolarity;
+        if (v[VcaMode] > 0.5f) sw2 |= SW2::kVcaGate;
+        sw2 |= static_cast<uint8_t>((static_cast<int>(v[HpfFreq]) & SW2::kHpfMask) << SW2::kHpfShift);
+        return sw2;
+    }
+
+    constexpr uint8_t encodeSlider(float value)
+    {
+        return static_cast<uint8_t>(value <= 0.0f ? 0 : (value >= 1.0f ? 127 : static_cast<int>(value * 127.0f + 0.5f)));
+    }
+
+    /** Decodes 16 sliders + SW1 + SW2 (constexpr: the factory table is decoded at compile time) */
+    constexpr PatchValues decodePatch(const uint8_t* bytes)
+    {
+        PatchValues v {};
+        for (int i = 0; i < JunoParams::NumPatchSliders; ++i)
+            v[(size_t)i] = static_cast<float>(bytes[i] & 0x7F) / 127.0f;
+        decodeSwitches1(bytes[16], v);
+        decodeSwitches2(bytes[17], v);
+        return v;
+    }
+
+    /** Inverse of decodePatch (18 bytes) */
+    constexpr void encodePatch(const PatchValues& v, uint8_t* bytes)
+    {
+        for (int i = 0; i < JunoParams::NumPatchSliders; ++i)
+            bytes[i] = encodeSlider(v[(size_t)i]);
+        bytes[16] = encodeSwitches1(v);
+        bytes[17] = encodeSwitches2(v);
+    }
+
+    //==============================================================================
     /** Creates a 7-byte Roland SysEx message for individual parameter changes (0x32) */
     inline juce::MidiMessage createParamChange(int channel, int paramId, int value)
     {
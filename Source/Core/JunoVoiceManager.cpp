@@ -1,7 +1,11 @@
 #include "JunoVoiceManager.h"
+#include <limits>
 
 JunoVoiceManager::JunoVoiceManager() {
     voiceTimestamps.fill(0);
+    for (auto& part : parts) {
+        part.noteToVoice.fill(-1);
+    }
     initVariances();
 }
 
@@ -19,17 +23,105 @@ void JunoVoiceManager::initVariances() {
         
         voices[i].setVariance(v);
     }
+    
+    setRandomSeed(1984);
+}
+
+void JunoVoiceManager::setRandomSeed(uint32_t seed) {
+    noise.setSeed(seed);
+    drift.setSeed(seed ^ 0x5A5A5A5Au);
+    for (int i = 0; i < MAX_VOICES; ++i) {
+        voices[i].setRandomSeed(seed + 0x9E3779B9u * static_cast<uint32_t>(i + 1));
+    }
 }
 
 void JunoVoiceManager::prepare(double sampleRate, int maxBlockSize) {
     for (auto& voice : voices) {
         voice.prepare(sampleRate, maxBlockSize);
     }
+    
+    noiseBuffer.setSize(1, juce::jmax(1, maxBlockSize));
+    for (auto& bus : taskBuses) {
+        bus.setSize(MAX_PARTS, juce::jmax(1, maxBlockSize));
+    }
+    noise.reset();
+    drift.prepare(sampleRate, MAX_VOICES);
+    
+    // Resync the free list with the voices
+    activeMask = 0;
+    for (auto& part : parts) {
+        part.voiceMask = 0;
+    }
+    for (int i = 0; i < MAX_VOICES; ++i) {
+        if (voices[i].isActive()) {
+            activeMask |= 1u << i;
+            parts[(size_t)voicePart[(size_t)i]].voiceMask |= 1u << i;
+        }
+    }
+}
+
+void JunoVoiceManager::setSampleRate(double sampleRate) {
+    for (auto& voice : voices) {
+        voice.setSampleRate(sampleRate);
+    }
+    drift.setSampleRate(sampleRate);
+}
+
+void JunoVoiceManager::setNumVoices(int count) {
+    count = juce::jlimit(1, MAX_VOICES, count);
+    if (count == numVoices) return;
+    
+    const uint32_t newPool = count >= 32 ? 0xFFFFFFFFu : (1u << count) - 1u;
+    for (uint32_t dropped = activeMask & poolMask & ~newPool; dropped != 0; dropped &= dropped - 1u) {
+        voices[lowestSetBit(dropped)].noteOff();
+    }
+    
+    numVoices = count;
+    poolMask = newPool;
+}
+
+void JunoVoiceManager::setNumParts(int count) {
+    count = juce::jlimit(1, MAX_PARTS, count);
+    if (count == numParts) return;
+    
+    for (int p = count; p < numParts; ++p) {
+        for (uint32_t mask = parts[(size_t)p].voiceMask; mask != 0; mask &= mask - 1u) {
+            voices[lowestSetBit(mask)].noteOff();
+        }
+    }
+    numParts = count;
+}
+
+void JunoVoiceManager::setPartReserve(int voicesPerPart) {
+    partReserve = juce::jlimit(0, MAX_VOICES, voicesPerPart);
 }
 
 void JunoVoiceManager::updateParams(const SynthParams& params) {
+    setNumVoices(params.numVoices);
+    updatePartParams(0, params);
+    drift.setAmount(params.drift);
+    tailFloorDb = params.tailFloorDb;
+}
+
+void JunoVoiceManager::updatePartParams(int partIndex, const SynthParams& params) {
+    auto& part = parts[(size_t)juce::jlimit(0, MAX_PARTS - 1, partIndex)];
+    part.params = params;
+    
+    // Idle voices pick the parameters up in noteOn()
+    for (uint32_t mask = part.voiceMask; mask != 0; mask &= mask - 1u) {
+        voices[lowestSetBit(mask)].updateParams(params);
+    }
+}
+
+void JunoVoiceManager::setOversamplingFactor(int factor) {
+    for (auto& voice : voices) {
+        voice.setOversamplingFactor(factor);
+    }
+}
+
+void JunoVoiceManager::setModulationBus(const JunoModulationBus* bus) {
     for (auto& voice : voices) {
-        voice.updateParams(params);
+        voice.setModulationBus(bus);
     }
 }
 
@@ -41,108 +133,292 @@ void JunoVoiceManager::renderNextBlock(juce::AudioBuffer<float>& buffer, int sta
     // To be safe and typical for a manager, we usually assume addition.
     // But since this is the primary source, PluginProcessor should clear it.
     
-    // We render each voice into a temp buffer and add, or add directly if Voice supports it.
-    // Voice::renderNextBlock typically adds to the buffer.
+    // Each voice adds itself to one mono channel with vector ops; stereo is
+    // expanded once by the processor, right before the chorus.
     
-    for (auto& voice : voices) {
-        if (voice.isActive()) {
-            voice.renderNextBlock(buffer, startSample, numSamples);
+    // One noise block for all voices (Juno-106: single noise generator);
+    // unshared, each voice fills its own lane from its own seed
+    noiseEnabled = false;
+    for (int p = 0; p < numParts && sharedNoise; ++p) {
+        noiseEnabled = noiseEnabled || parts[(size_t)p].params.noiseLevel > 0.0f;
+    }
+    if (noiseEnabled) {
+        // Sized for the top oversampling tier in prepare(); the processor splits longer blocks
+        jassert(startSample + numSamples <= noiseBuffer.getNumSamples());
+        noise.fill(noiseBuffer.getWritePointer(0, startSample), numSamples);
+    }
+    const float* noiseData = noiseEnabled ? noiseBuffer.getReadPointer(0) : nullptr;
+    
+    // Drift: one frequency ratio per voice for this block
+    drift.advance(numSamples);
+    
+    // Tail cull floor (the CPU governor may raise it)
+    const float floorDb = tailCulling ? juce::jmax(tailFloorDb, kEconomyTailFloorDb) : tailFloorDb;
+    const float tailFloor = floorDb > kTailFloorOffDb ? juce::Decibels::decibelsToGain(floorDb, kTailFloorOffDb) : 0.0f;
+    
+    renderCount = 0;
+    for (uint32_t mask = activeMask; mask != 0; mask &= mask - 1u) {
+        const int i = lowestSetBit(mask);
+        auto& voice = voices[(size_t)i];
+        voice.setNoiseSource(noiseData);
+        voice.setDriftRatio(drift.getFrequencyRatio(i));
+        voice.setTailFloor(tailFloor);
+        renderList[(size_t)renderCount++] = i;
+    }
+    
+    // Output channels in use: one per part (mono buffer = everything mixed)
+    renderChannels = juce::jlimit(1, MAX_PARTS, buffer.getNumChannels());
+    
+    // Parallel only when there is enough work to pay for the hand-off
+    const int workers = renderPool != nullptr ? renderPool->getNumWorkers() : 0;
+    const bool parallel = workers > 0 && renderCount > 1 && numSamples >= kMinParallelSamples
+                       && startSample + numSamples <= taskBuses[0].getNumSamples();
+    
+    if (parallel) {
+        renderTasks = juce::jmin(renderCount, workers + 1, kMaxRenderTasks);
+        renderStart = startSample;
+        renderLength = numSamples;
+        renderPool->run(renderTasks, &JunoVoiceManager::renderTask, this);
+        
+        // Join done: sum the private buses in a fixed order
+        for (int t = 0; t < renderTasks; ++t) {
+            for (int ch = 0; ch < renderChannels; ++ch) {
+                buffer.addFrom(ch, startSample, taskBuses[(size_t)t], ch, startSample, numSamples);
+            }
+        }
+    } else {
+        for (int n = 0; n < renderCount; ++n) {
+            renderVoice(renderList[(size_t)n], buffer, startSample, numSamples);
         }
     }
+    
+    // Envelope finished (or tail culled) during this block
+    for (int n = 0; n < renderCount; ++n) {
+        if (!voices[(size_t)renderList[(size_t)n]].isActive()) {
+            releaseVoiceSlot(renderList[(size_t)n]);
+        }
+    }
+}
+
+void JunoVoiceManager::renderTask(void* context, int taskIndex) {
+    auto& manager = *static_cast<JunoVoiceManager*>(context);
+    auto& bus = manager.taskBuses[(size_t)taskIndex];
+    for (int ch = 0; ch < manager.renderChannels; ++ch) {
+        bus.clear(ch, manager.renderStart, manager.renderLength);
+    }
+    
+    for (int n = taskIndex; n < manager.renderCount; n += manager.renderTasks) {
+        manager.renderVoice(manager.renderList[(size_t)n], bus, manager.renderStart, manager.renderLength);
+    }
+}
+
+void JunoVoiceManager::renderVoice(int index, juce::AudioBuffer<float>& target, int startSample, int numSamples) {
+    if (target.getNumChannels() == 1) {
+        voices[(size_t)index].renderNextBlock(target, startSample, numSamples);
+        return;
+    }
+    
+    // A one-channel view on the part's channel (no allocation)
+    float* channel = target.getWritePointer(juce::jmin((int)voicePart[(size_t)index], renderChannels - 1));
+    juce::AudioBuffer<float> partView(&channel, 1, target.getNumSamples());
+    voices[(size_t)index].renderNextBlock(partView, startSample, numSamples);
+}
+
+void JunoVoiceManager::releaseVoiceSlot(int index) {
+    const uint32_t bit = 1u << index;
+    auto& part = parts[(size_t)voicePart[(size_t)index]];
+    activeMask &= ~bit;
+    part.voiceMask &= ~bit;
+    
+    const int note = voices[index].getCurrentNote();
+    if (note >= 0 && part.noteToVoice[(size_t)note] == index) {
+        part.noteToVoice[(size_t)note] = -1;
+    }
 }
 
-void JunoVoiceManager::setPolyMode(int mode) {
-    if (polyMode != mode) {
-        polyMode = mode;
-        setAllNotesOff(); // Prevent stuck notes when switching modes
+void JunoVoiceManager::assignVoice(int index, int partIndex) {
+    if (voices[index].isActive()) {
+        releaseVoiceSlot(index); // Stolen: unmap its old note
+    }
+    voicePart[(size_t)index] = static_cast<int8_t>(partIndex);
+    parts[(size_t)partIndex].voiceMask |= 1u << index;
+    activeMask |= 1u << index;
+}
+
+void JunoVoiceManager::setPolyMode(int mode, int partIndex) {
+    auto& part = parts[(size_t)juce::jlimit(0, MAX_PARTS - 1, partIndex)];
+    if (part.polyMode != mode) {
+        part.polyMode = mode;
+        // Prevent stuck notes when switching modes
+        for (uint32_t mask = part.voiceMask; mask != 0; mask &= mask - 1u) {
+            voices[lowestSetBit(mask)].noteOff();
+        }
     }
 }
 
-void JunoVoiceManager::noteOn(int midiChannel, int midiNote, float velocity) {
+void JunoVoiceManager::noteOn(int partIndex, int midiNote, float velocity) {
+    partIndex = juce::jlimit(0, numParts - 1, partIndex);
+    auto& part = parts[(size_t)partIndex];
     currentTimestamp++;
     
     // === UNISON MODE (3) ===
-    // Triggers ALL voices for the same note.
-    if (polyMode == 3) {
-        for (int i = 0; i < MAX_VOICES; ++i) {
+    // Triggers ALL voices of the part for the same note (single part: the whole pool)
+    if (part.polyMode == 3) {
+        const uint32_t stack = (part.voiceMask & poolMask) | getAvailableVoices(partIndex);
+        for (uint32_t mask = stack; mask != 0; mask &= mask - 1u) {
+            const int i = lowestSetBit(mask);
+            if (!voices[i].isActive()) voices[i].updateParams(part.params);
+            assignVoice(i, partIndex);
             voices[i].noteOn(midiNote, velocity);
             voiceTimestamps[i] = currentTimestamp;
         }
-        lastAllocatedVoiceIndex = 0; // Reset
+        part.lastAllocatedVoiceIndex = 0; // Reset
+        lastAllocatedVoiceIndex = 0;
         return;
     }
     
     // === POLY MODES (1 & 2) ===
     
     // 1. Check for retrigger (Same note already playing)
-    for (int i = 0; i < MAX_VOICES; ++i) {
-        if (voices[i].isActive() && voices[i].getCurrentNote() == midiNote) {
-            voices[i].noteOn(midiNote, velocity);
-            voiceTimestamps[i] = currentTimestamp;
-            lastAllocatedVoiceIndex = i; // Update last allocated even on retrigger
-            return;
-        }
+    const int playing = part.noteToVoice[(size_t)midiNote];
+    if (playing >= 0 && voices[playing].isActive() && voices[playing].getCurrentNote() == midiNote) {
+        voices[playing].noteOn(midiNote, velocity);
+        voiceTimestamps[playing] = currentTimestamp;
+        part.lastAllocatedVoiceIndex = playing; // Update last allocated even on retrigger
+        lastAllocatedVoiceIndex = playing;
+        return;
     }
     
     // 2. Find free voice strategy
-    int voiceIndex = findFreeVoiceIndex();
+    int voiceIndex = findFreeVoiceIndex(partIndex);
     
     // 3. Stealing (if no free voice)
     if (voiceIndex == -1) {
-        voiceIndex = findVoiceToSteal();
+        voiceIndex = findVoiceToSteal(partIndex);
     }
     
     // 4. Allocate
     if (voiceIndex != -1) {
-        voices[voiceIndex].noteOn(midiNote, velocity);
+        auto& voice = voices[voiceIndex];
+        if (!voice.isActive() || voicePart[(size_t)voiceIndex] != partIndex) {
+            voice.updateParams(part.params);
+        }
+        assignVoice(voiceIndex, partIndex);
+        voice.noteOn(midiNote, velocity);
         voiceTimestamps[voiceIndex] = currentTimestamp;
+        part.noteToVoice[(size_t)midiNote] = static_cast<int8_t>(voiceIndex);
+        part.lastAllocatedVoiceIndex = voiceIndex;
         lastAllocatedVoiceIndex = voiceIndex;
     }
 }
 
-void JunoVoiceManager::noteOff(int midiChannel, int midiNote, float velocity) {
+void JunoVoiceManager::noteOff(int partIndex, int midiNote, float velocity) {
+    // Same mapping as noteOn (parts beyond numParts were released by setNumParts)
+    partIndex = juce::jlimit(0, numParts - 1, partIndex);
+    auto& part = parts[(size_t)partIndex];
+    
     // If Unison, kill all matching notes
-    if (polyMode == 3) {
-        for (int i = 0; i < MAX_VOICES; ++i) {
-             if (voices[i].getCurrentNote() == midiNote) {
-                 voices[i].noteOff();
+    if (part.polyMode == 3) {
+        for (uint32_t mask = part.voiceMask; mask != 0; mask &= mask - 1u) {
+             auto& voice = voices[lowestSetBit(mask)];
+             if (voice.getCurrentNote() == midiNote) {
+                 voice.noteOff();
              }
         }
         return;
     }
 
     // Poly Mode: Kill specific voice
-    for (int i = 0; i < MAX_VOICES; ++i) {
-        if (voices[i].isActive() && voices[i].getCurrentNote() == midiNote) {
-            voices[i].noteOff();
-            return;
+    const int playing = part.noteToVoice[(size_t)midiNote];
+    if (playing >= 0 && voices[playing].isActive() && voices[playing].getCurrentNote() == midiNote) {
+        voices[playing].noteOff();
+    }
+}
+
+uint32_t JunoVoiceManager::getAvailableVoices(int partIndex) const {
+    const uint32_t freeMask = poolMask & ~activeMask;
+    if (numParts == 1 || partReserve == 0) return freeMask;
+    
+    // Free voices still owed to the other parts' reservations stay untouched
+    int owed = 0;
+    for (int p = 0; p < numParts; ++p) {
+        if (p != partIndex) {
+            owed += juce::jmax(0, partReserve - countBits(parts[(size_t)p].voiceMask & poolMask));
         }
     }
+    
+    // The lowest free voices are available, the owed ones are left on top
+    int keep = countBits(freeMask) - owed;
+    uint32_t available = 0;
+    for (uint32_t mask = freeMask; mask != 0 && keep > 0; mask &= mask - 1u, --keep) {
+        available |= mask & (~mask + 1u);
+    }
+    return available;
 }
 
-int JunoVoiceManager::findFreeVoiceIndex() {
+int JunoVoiceManager::findFreeVoiceIndex(int partIndex) {
+    const auto& part = parts[(size_t)partIndex];
+    const uint32_t freeMask = getAvailableVoices(partIndex);
+    if (freeMask == 0) return -1;
+    
     // Poly 1: Cyclic (Round Robin) - Authentic natural release
-    if (polyMode == 1) {
-        for (int i = 0; i < MAX_VOICES; ++i) {
-            int idx = (lastAllocatedVoiceIndex + 1 + i) % MAX_VOICES;
-            if (!voices[idx].isActive()) return idx;
-        }
+    if (part.polyMode == 1) {
+        // First free voice after the last allocated one, wrapping around
+        const int start = (part.lastAllocatedVoiceIndex + 1) % numVoices;
+        const uint32_t after = freeMask & ~((1u << start) - 1u);
+        return lowestSetBit(after != 0 ? after : freeMask);
     }
     // Poly 2: Lowest Free (Linear) - Tends to cut tails, cleaner
-    else if (polyMode == 2) {
-         for (int i = 0; i < MAX_VOICES; ++i) {
-            if (!voices[i].isActive()) return i;
-        }
+    else if (part.polyMode == 2) {
+        return lowestSetBit(freeMask);
     }
     
     return -1;
 }
 
-int JunoVoiceManager::findVoiceToSteal() {
+int JunoVoiceManager::findVoiceToSteal(int partIndex) {
+    const uint32_t own = parts[(size_t)partIndex].voiceMask & poolMask;
+    
+    // Below its reservation a part takes voices back from parts that borrowed
+    // beyond theirs; otherwise it steals from itself
+    if (numParts > 1 && countBits(own) < partReserve) {
+        uint32_t borrowed = 0;
+        for (int p = 0; p < numParts; ++p) {
+            const uint32_t other = parts[(size_t)p].voiceMask & poolMask;
+            if (p != partIndex && countBits(other) > partReserve) borrowed |= other;
+        }
+        if (borrowed != 0) return findVoiceToStealFrom(borrowed);
+    }
+    if (own != 0) return findVoiceToStealFrom(own);
+    
+    return findVoiceToStealFrom(activeMask & poolMask);
+}
+
+int JunoVoiceManager::findVoiceToStealFrom(uint32_t candidates) const {
+    // 1. A voice already fading out is inaudible: reuse it
+    for (uint32_t mask = candidates; mask != 0; mask &= mask - 1u) {
+        const int i = lowestSetBit(mask);
+        if (voices[i].isRetiring()) return i;
+    }
+    
+    // 2. The quietest release tail
+    int quietestIndex = -1;
+    float minPeak = std::numeric_limits<float>::max();
+    for (uint32_t mask = candidates; mask != 0; mask &= mask - 1u) {
+        const int i = lowestSetBit(mask);
+        if (voices[i].isReleasing() && voices[i].getOutputPeak() < minPeak) {
+            minPeak = voices[i].getOutputPeak();
+            quietestIndex = i;
+        }
+    }
+    if (quietestIndex != -1) return quietestIndex;
+    
+    // 3. The oldest note
     int oldestIndex = -1;
     uint64_t minTimestamp = UINT64_MAX;
     
-    for (int i = 0; i < MAX_VOICES; ++i) {
+    for (uint32_t mask = candidates; mask != 0; mask &= mask - 1u) {
+        const int i = lowestSetBit(mask);
         if (voiceTimestamps[i] < minTimestamp) {
             minTimestamp = voiceTimestamps[i];
             oldestIndex = i;
@@ -154,14 +430,14 @@ int JunoVoiceManager::findVoiceToSteal() {
 
 void JunoVoiceManager::outputActiveVoiceInfo() {
     juce::String state;
-    for (int i = 0; i < MAX_VOICES; ++i) {
-        state += "[" + juce::String(i) + ":" + (voices[i].isActive() ? juce::String(voices[i].getCurrentNote()) : ".") + "] ";
+    for (int i = 0; i < numVoices; ++i) {
+        state += "[" + juce::String(i) + ":" + (voices[i].isActive() ? juce::String(voicePart[(size_t)i] + 1) + "/" + juce::String(voices[i].getCurrentNote()) : ".") + "] ";
     }
     DBG("Voices: " << state);
 }
 
 void JunoVoiceManager::setAllNotesOff() {
-    for (auto& voice : voices) {
-        voice.noteOff();
+    for (uint32_t mask = activeMask; mask != 0; mask &= mask - 1u) {
+        voices[lowestSetBit(mask)].noteOff();
     }
 }
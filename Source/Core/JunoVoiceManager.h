@@ -3,54 +3,175 @@
 #include <JuceHeader.h>
 #include "../Synth/Voice.h"
 #include "SynthParams.h"
+#include "../Synth/JunoModulationBus.h"
+#include "../Synth/JunoNoise.h"
+#include "../Synth/JunoDrift.h"
+#include "JunoRenderPool.h"
 #include <array>
 
 /**
  * JunoVoiceManager
  * 
- * Handles the allocation and lifecycle of 6 fixed voices, mimicking the
+ * Handles the allocation and lifecycle of the voices, mimicking the
  * Roland Juno-106 architecture (DCOs 1-6).
  * 
- * - Fixed 6-voice polyphony
+ * - 6 voices by default (authentic), up to 32 for stacked pads
+ * - O(1) allocation: active/free voices are bits in a mask, notes are
+ *   mapped to their voice; render and stealing only visit active voices
  * - Round-Robin allocation
- * - Voice stealing based on oldest timestamp
+ * - Voice stealing: retiring tails first, then the quietest release, then the oldest note
+ * - Silent release tails are culled below a dBFS floor
  * - Centralized parameter updates
+ * - Single noise source shared by all voices (as on the hardware), or one
+ *   independent generator per voice (setSharedNoise(false): uncorrelated
+ *   noise in stacked/unison voices)
+ * - Shared thermal drift model, updated once per block
+ * - Optional parallel rendering: voice groups on a worker pool, each into
+ *   a private bus, summed in a fixed order after the join
+ * - Multitimbral parts: each part has its own patch, poly mode and note map
+ *   and draws voices from the shared pool. A part is guaranteed its reserved
+ *   voices; the rest go to whichever part asks first. Voices of part p are
+ *   rendered into channel p of the output buffer (clamped to its last channel)
  */
 class JunoVoiceManager {
 public:
     JunoVoiceManager();
     
     void prepare(double sampleRate, int maxBlockSize);
+    
+    // Rate change while voices sound (audio thread safe: no reset, no allocation)
+    void setSampleRate(double sampleRate);
     void renderNextBlock(juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
     
-    void noteOn(int midiChannel, int midiNote, float velocity);
-    void noteOff(int midiChannel, int midiNote, float velocity);
+    void noteOn(int part, int midiNote, float velocity);
+    void noteOff(int part, int midiNote, float velocity);
     void outputActiveVoiceInfo(); // Debug helper
     
-    // Updates all voices with the current parameter state
+    // Updates all voices with the current parameter state (part 0 and the
+    // engine-wide settings: voice count, tail floor, noise, drift)
     // Should be called once per block, not per sample
     void updateParams(const SynthParams& params);
     
-    void setPolyMode(int mode); // 1-Poly1, 2-Poly2, 3-Unison
+    // Patch of one part (1..numParts-1), once per block
+    void updatePartParams(int part, const SynthParams& params);
+    
+    // Multitimbral layout. Fewer parts: the dropped parts release their notes
+    void setNumParts(int count);
+    int getNumParts() const { return numParts; }
+    void setPartReserve(int voicesPerPart);
+    
+    // Connects every voice to the shared performance controller lanes
+    void setModulationBus(const JunoModulationBus* bus);
+    
+    // Worker pool for parallel rendering (nullptr or no workers = serial)
+    void setRenderPool(JunoRenderPool* pool) { renderPool = pool; }
+    
+    // CPU economy: raises the tail cull floor to kEconomyTailFloorDb
+    void setTailCulling(bool enabled) { tailCulling = enabled; }
+    
+    // Voices render at factor x the host rate (prepare() with the oversampled rate)
+    void setOversamplingFactor(int factor);
+    
+    // Noise and drift seed (same seed = identical renders)
+    void setRandomSeed(uint32_t seed);
+    
+    // One noise block for all voices (default), or each voice's own generator
+    void setSharedNoise(bool shared) { sharedNoise = shared; }
+    bool isNoiseShared() const { return sharedNoise; }
+    
+    void setPolyMode(int mode, int part = 0); // 1-Poly1, 2-Poly2, 3-Unison
+    
+    // Voices in use (1..MAX_VOICES). Voices dropped from the pool release normally
+    void setNumVoices(int count);
+    int getNumVoices() const { return numVoices; }
+    
     int getLastTriggeredVoiceIndex() const { return lastAllocatedVoiceIndex; }
     void setAllNotesOff();
 
+    static constexpr int MAX_VOICES = 32;     // Storage (one bit per voice)
+    static constexpr int DEFAULT_VOICES = 6;  // Juno-106
+    static constexpr int MAX_PARTS = 4;
+
 private:
-    static constexpr int MAX_VOICES = 6;
     std::array<Voice, MAX_VOICES> voices;
+    int numVoices = DEFAULT_VOICES;
+    
+    // Bit i = voice i. activeMask: sounding; poolMask: the first numVoices
+    uint32_t activeMask = 0;
+    uint32_t poolMask = (1u << DEFAULT_VOICES) - 1;
+    
+    // One timbre: patch (applied to idle voices at note-on), allocation
+    // policy and the voices it currently owns
+    struct Part {
+        SynthParams params;
+        int polyMode = 1;                  // 1=Poly1, 2=Poly2, 3=Unison
+        int lastAllocatedVoiceIndex = -1;  // For Round-Robin
+        uint32_t voiceMask = 0;            // Active voices owned by this part
+        std::array<int8_t, 128> noteToVoice; // Voice each note was last allocated to, -1 = none
+    };
+    std::array<Part, MAX_PARTS> parts;
+    std::array<int8_t, MAX_VOICES> voicePart {};  // Owner of each voice
+    int numParts = 1;
+    int partReserve = 0;
     
     // Timestamps for voice stealing (incremented on noteOn)
     std::array<uint64_t, MAX_VOICES> voiceTimestamps;
     uint64_t currentTimestamp = 0;
     
-    int lastAllocatedVoiceIndex = -1; // For Round-Robin
-    int polyMode = 1; // 1=Poly1, 2=Poly2, 3=Unison
+    int lastAllocatedVoiceIndex = -1; // Any part (test mode display)
+    
+    // Shared noise generator, filled once per block
+    JunoNoise noise;
+    juce::AudioBuffer<float> noiseBuffer;
+    bool noiseEnabled = false;
+    bool sharedNoise = true;
+    
+    // Analog pitch drift (shared thermal state + per-voice wander)
+    JunoDrift drift;
+    
+    // Silent-tail culling (floor in dBFS, at or below kTailFloorOffDb = off)
+    static constexpr float kTailFloorOffDb = -120.0f;
+    static constexpr float kEconomyTailFloorDb = -60.0f;
+    float tailFloorDb = -96.0f;
+    bool tailCulling = false;
+    
+    // Free voices a part may take without touching other parts' reservations
+    uint32_t getAvailableVoices(int part) const;
     
     // Finds the best voice to play a new note
-    int findFreeVoiceIndex();
+    int findFreeVoiceIndex(int part);
+    
+    // Finds the voice to steal (retiring, quietest release, then oldest)
+    int findVoiceToSteal(int part);
+    int findVoiceToStealFrom(uint32_t candidates) const;
+    
+    // Hands a voice to a part (stealing it from its current owner if needed)
+    void assignVoice(int index, int part);
+    
+    // Parallel rendering: voice list for this block, split into groups
+    // (group t = voices t, t + numTasks, ...); one private bus per group,
+    // with one channel per output channel of the block
+    static constexpr int kMaxRenderTasks = JunoRenderPool::kMaxWorkers + 1;
+    static constexpr int kMinParallelSamples = 64;  // Smaller blocks: sync costs more than it saves
+    JunoRenderPool* renderPool = nullptr;
+    std::array<juce::AudioBuffer<float>, kMaxRenderTasks> taskBuses;
+    std::array<int, MAX_VOICES> renderList {};
+    int renderCount = 0;
+    int renderTasks = 0;
+    int renderStart = 0;
+    int renderLength = 0;
+    int renderChannels = 1;
+    
+    static void renderTask(void* context, int taskIndex);
+    
+    // Voice render into channel voicePart of the target (one channel view)
+    void renderVoice(int index, juce::AudioBuffer<float>& target, int startSample, int numSamples);
+    
+    // Clears a voice that went idle from the active mask and note map
+    void releaseVoiceSlot(int index);
     
-    // Finds the oldest voice to steal
-    int findVoiceToSteal();
+    static int lowestSetBit(uint32_t mask) { return juce::findHighestSetBit(mask & (~mask + 1u)); }
+    static int countBits(uint32_t mask) { return juce::countNumberOfBitsSet(mask); }
     
     // Analog Emulation
     void initVariances();
@@ -1,70 +1,152 @@
 #pragma once
 #include <JuceHeader.h>
 #include <map>
+#include <set>
+#include <array>
+#include <atomic>
+#include <vector>
+#include <algorithm>
 
 /**
  * MidiLearnHandler - Manages MIDI CC to Parameter mappings and Learn mode.
+ *
+ * Mappings are edited on the message thread (ccToParam / nrpnToParam) and
+ * compiled into a DispatchTable of direct parameter pointers. The table is
+ * published atomically, so the audio thread resolves a CC with one array
+ * index instead of a map lookup plus a String parameter search.
+ *
+ * Controller types:
+ * - 7-bit CC (any CC that is not reserved)
+ * - 14-bit CC pairs (MSB 0-31 + LSB 32-63)
+ * - NRPN (CC 99/98 select, CC 6/38 data entry, always 14-bit)
  */
-class MidiLearnHandler
+class MidiLearnHandler : private juce::AsyncUpdater
 {
 public:
     MidiLearnHandler() = default;
+    ~MidiLearnHandler() override { cancelPendingUpdate(); }
 
     static bool isProtectedCC(int cc) {
         return cc == 1 || cc == 64; // Mod Wheel & Sustain
     }
 
-    /** Processes an incoming CC message */
-    void handleIncomingCC(int ccNumber, int value, juce::AudioProcessorValueTreeState& apvts)
+    /** Data Entry / (N)RPN select CCs are consumed by the NRPN parser */
+    static bool isParameterNumberCC(int cc) {
+        return cc == 6 || cc == 38 || (cc >= 98 && cc <= 101);
+    }
+
+    /** Connects the handler to the parameters it drives and compiles the table */
+    void attachTo(juce::AudioProcessorValueTreeState& state)
+    {
+        apvts = &state;
+        rebuildDispatchTable();
+    }
+
+    /** Processes an incoming CC message (audio thread) */
+    void handleIncomingCC(int midiChannel, int ccNumber, int value)
     {
-        if (isLearning && learningParamID.isNotEmpty())
+        if (ccNumber < 0 || ccNumber > 127) return;
+        auto& ch = channelStates[static_cast<size_t>(juce::jlimit(1, 16, midiChannel) - 1)];
+
+        // NRPN selection and data entry are parsed even while learning
+        if (isParameterNumberCC(ccNumber))
+        {
+            handleParameterNumberCC(ch, ccNumber, value);
+            return;
+        }
+
+        if (isLearning.load())
         {
             if (isProtectedCC(ccNumber)) return; // Ignore protected CCs
-            
-            bind(ccNumber, learningParamID);
-            isLearning = false;
-            learningParamID = "";
-            
-            if (onMappingChanged) onMappingChanged();
+            commitLearn(kLearnCC, ccNumber);
             return;
         }
 
-        auto it = ccToParam.find(ccNumber);
-        if (it != ccToParam.end())
+        audioThreadReading.store(true);
+        const auto* table = liveTable.load();
+        const auto& entry = table->cc[static_cast<size_t>(ccNumber)];
+
+        switch (entry.kind)
+        {
+            case EntryKind::CC7:
+                setParameter(entry.param, value / 127.0f);
+                break;
+            case EntryKind::CC14MSB:
+                // MIDI spec: a new MSB resets the fine part
+                ch.ccMSB[static_cast<size_t>(ccNumber)] = static_cast<uint8_t>(value);
+                setParameter(entry.param, (value << 7) / 16383.0f);
+                break;
+            case EntryKind::CC14LSB:
+                setParameter(entry.param, ((ch.ccMSB[static_cast<size_t>(ccNumber - 32)] << 7) | value) / 16383.0f);
+                break;
+            case EntryKind::None:
+                break;
+        }
+
+        audioThreadReading.store(false);
+    }
+
+    /**
+     * Binds a CC number to a parameter ID (7-bit, or 14-bit when highResolution is set).
+     * A 14-bit bind fails (and changes nothing) while its LSB controller is mapped to
+     * another parameter: the caller reports it instead of that mapping disappearing.
+     */
+    juce::Result bind(int ccNumber, const juce::String& paramID, bool highResolution = false)
+    {
+        // A 14-bit pair is addressed by its MSB controller
+        if (highResolution && ccNumber >= 32 && ccNumber < 64) ccNumber -= 32;
+        highResolution = highResolution && ccNumber >= 0 && ccNumber < 32;
+
+        if (highResolution)
+        {
+            auto lsb = ccToParam.find(ccNumber + 32);
+            if (lsb != ccToParam.end() && lsb->second != paramID)
+                return juce::Result::fail("CC " + juce::String(ccNumber + 32) + " is mapped to " + getParameterName(lsb->second)
+                                          + ". Clear that mapping to use CC " + juce::String(ccNumber) + " as a 14-bit pair.");
+        }
+
+        eraseParam(paramID); // Ensure one-to-one
+        if (ccNumber >= 0 && ccNumber <= 127 && !isParameterNumberCC(ccNumber))
         {
-            if (auto* param = apvts.getParameter(it->second))
+            eraseCC(ccNumber);
+            if (highResolution)
             {
-                float normalizedValue = value / 127.0f;
-                param->setValueNotifyingHost(normalizedValue);
+                eraseCC(ccNumber + 32);
+                highResCCs.insert(ccNumber);
             }
+            ccToParam[ccNumber] = paramID;
         }
+        rebuildDispatchTable();
+        return juce::Result::ok();
     }
 
-    /** Binds a CC number to a parameter ID */
-    void bind(int ccNumber, const juce::String& paramID)
+    /** Binds a 14-bit NRPN number (0-16383) to a parameter ID */
+    void bindNRPN(int nrpnNumber, const juce::String& paramID)
     {
-        unbindParam(paramID); // Ensure one-to-one
-        ccToParam[ccNumber] = paramID;
+        eraseParam(paramID);
+        if (nrpnNumber >= 0 && nrpnNumber < 16384)
+            nrpnToParam[nrpnNumber] = paramID;
+        rebuildDispatchTable();
     }
-    
+
     /** Unbinds a specific CC */
     void unbindCC(int ccNumber) {
-        ccToParam.erase(ccNumber);
+        eraseCC(ccNumber);
+        rebuildDispatchTable();
     }
-    
-    /** Unbinds a specific Parameter */
+
+    /** Unbinds a specific Parameter (CC and NRPN) */
     void unbindParam(const juce::String& paramID) {
-        for (auto it = ccToParam.begin(); it != ccToParam.end(); ) {
-            if (it->second == paramID) it = ccToParam.erase(it);
-            else ++it;
-        }
+        eraseParam(paramID);
+        rebuildDispatchTable();
     }
 
     /** Enables learn mode for a specific parameter */
-    void startLearning(const juce::String& paramID)
+    void startLearning(const juce::String& paramID, bool highResolution = false)
     {
-        isLearning = true;
         learningParamID = paramID;
+        learnHighResolution = highResolution;
+        isLearning.store(true);
     }
 
     /** Returns the CC mapped to a parameter, or -1 if none */
@@ -77,8 +159,36 @@ public:
         return -1;
     }
 
+    /** Returns the NRPN mapped to a parameter, or -1 if none */
+    int getNRPNForParam(const juce::String& paramID) const
+    {
+        for (auto const& [nrpn, id] : nrpnToParam)
+        {
+            if (id == paramID) return nrpn;
+        }
+        return -1;
+    }
+
+    bool isHighResolution(int ccNumber) const { return highResCCs.count(ccNumber) > 0; }
+
+    /** Human-readable mapping for menus, e.g. "CC 23", "CC 7 (14-bit)", "NRPN 1024" */
+    juce::String getMappingDescription(const juce::String& paramID) const
+    {
+        int cc = getCCForParam(paramID);
+        if (cc >= 0) return "CC " + juce::String(cc) + (isHighResolution(cc) ? " (14-bit)" : "");
+        int nrpn = getNRPNForParam(paramID);
+        if (nrpn >= 0) return "NRPN " + juce::String(nrpn);
+        return {};
+    }
+
     /** Reset all mappings */
-    void clearMappings() { ccToParam.clear(); }
+    void clearMappings()
+    {
+        ccToParam.clear();
+        highResCCs.clear();
+        nrpnToParam.clear();
+        rebuildDispatchTable();
+    }
 
     /** Serializes mappings to a ValueTree */
     juce::ValueTree saveState() const
@@ -89,6 +199,14 @@ public:
             juce::ValueTree entry("MAP");
             entry.setProperty("cc", cc, nullptr);
             entry.setProperty("param", id, nullptr);
+            if (isHighResolution(cc)) entry.setProperty("hires", true, nullptr);
+            vt.appendChild(entry, nullptr);
+        }
+        for (auto const& [nrpn, id] : nrpnToParam)
+        {
+            juce::ValueTree entry("MAP");
+            entry.setProperty("nrpn", nrpn, nullptr);
+            entry.setProperty("param", id, nullptr);
             vt.appendChild(entry, nullptr);
         }
         return vt;
@@ -98,30 +216,268 @@ public:
     void loadState(const juce::ValueTree& vt)
     {
         if (vt.getType() != juce::Identifier("MIDI_MAPPINGS")) return;
-        
+
         ccToParam.clear();
+        highResCCs.clear();
+        nrpnToParam.clear();
         for (int i = 0; i < vt.getNumChildren(); ++i)
         {
             auto child = vt.getChild(i);
             if (child.getType() == juce::Identifier("MAP"))
             {
-                int cc = child.getProperty("cc");
                 juce::String id = child.getProperty("param");
-                if (cc >= 0 && cc <= 127 && id.isNotEmpty())
+                if (id.isEmpty()) continue;
+
+                if (child.hasProperty("nrpn"))
+                {
+                    int nrpn = child.getProperty("nrpn");
+                    if (nrpn >= 0 && nrpn < 16384) nrpnToParam[nrpn] = id;
+                    continue;
+                }
+
+                int cc = child.getProperty("cc");
+                if (cc >= 0 && cc <= 127 && !isParameterNumberCC(cc))
                 {
                     ccToParam[cc] = id;
+                    if ((bool)child.getProperty("hires", false) && cc < 32) highResCCs.insert(cc);
                 }
             }
         }
+        rebuildDispatchTable();
+    }
+
+    /** Binary form of the mappings (plugin state chunk): count, then kind / number / ID */
+    void writeMappings(juce::OutputStream& out) const
+    {
+        out.writeCompressedInt(static_cast<int>(ccToParam.size() + nrpnToParam.size()));
+        for (auto const& [cc, id] : ccToParam)
+        {
+            out.writeByte(static_cast<char>(isHighResolution(cc) ? StoredCC14 : StoredCC7));
+            out.writeCompressedInt(cc);
+            out.writeString(id);
+        }
+        for (auto const& [nrpn, id] : nrpnToParam)
+        {
+            out.writeByte(static_cast<char>(StoredNRPN));
+            out.writeCompressedInt(nrpn);
+            out.writeString(id);
+        }
     }
 
-    bool getIsLearning() const { return isLearning; }
+    void readMappings(juce::InputStream& in)
+    {
+        ccToParam.clear();
+        highResCCs.clear();
+        nrpnToParam.clear();
+        const int count = in.readCompressedInt();
+        for (int i = 0; i < count && !in.isExhausted(); ++i)
+        {
+            const int kind = in.readByte();
+            const int number = in.readCompressedInt();
+            const juce::String id = in.readString();
+            if (id.isEmpty()) continue;
+
+            if (kind == StoredNRPN)
+            {
+                if (number >= 0 && number < 16384) nrpnToParam[number] = id;
+            }
+            else if (number >= 0 && number <= 127 && !isParameterNumberCC(number))
+            {
+                ccToParam[number] = id;
+                if (kind == StoredCC14 && number < 32) highResCCs.insert(number);
+            }
+        }
+        rebuildDispatchTable();
+    }
+
+    bool getIsLearning() const { return isLearning.load(); }
     juce::String getLearningParamID() const { return learningParamID; }
 
     std::function<void()> onMappingChanged;
+    std::function<void(const juce::String& reason)> onMappingRejected;   // Learned bind refused (message thread)
 
 private:
+    enum class EntryKind : uint8_t { None, CC7, CC14MSB, CC14LSB };
+
+    // Mapping kinds in the binary state
+    enum StoredKind { StoredCC7 = 0, StoredCC14 = 1, StoredNRPN = 2 };
+
+    struct Entry {
+        juce::RangedAudioParameter* param = nullptr;
+        EntryKind kind = EntryKind::None;
+    };
+
+    /** Compiled, immutable view of the mappings read by the audio thread */
+    struct DispatchTable {
+        std::array<Entry, 128> cc {};
+        std::vector<std::pair<int, juce::RangedAudioParameter*>> nrpn; // Sorted by NRPN number
+        uint32_t generation = 0;
+    };
+
+    /** Running (N)RPN / 14-bit parser state, one per MIDI channel (audio thread only) */
+    struct ChannelState {
+        std::array<uint8_t, 32> ccMSB {};
+        int selectedNRPN = -1;          // -1 = none (or an RPN is selected)
+        int nrpnMSB = 127;
+        int nrpnLSB = 127;
+        int dataMSB = 0;
+        juce::RangedAudioParameter* nrpnTarget = nullptr;
+        uint32_t resolvedGeneration = 0;
+    };
+
+    static constexpr int kLearnCC = 0;
+    static constexpr int kLearnNRPN = 1;
+
+    juce::String getParameterName(const juce::String& paramID) const {
+        auto* param = apvts != nullptr ? apvts->getParameter(paramID) : nullptr;
+        return param != nullptr ? param->getName(64) : paramID;
+    }
+
+    void eraseCC(int ccNumber) {
+        ccToParam.erase(ccNumber);
+        highResCCs.erase(ccNumber);
+    }
+
+    void eraseParam(const juce::String& paramID) {
+        for (auto it = ccToParam.begin(); it != ccToParam.end(); ) {
+            if (it->second == paramID) { highResCCs.erase(it->first); it = ccToParam.erase(it); }
+            else ++it;
+        }
+        for (auto it = nrpnToParam.begin(); it != nrpnToParam.end(); ) {
+            if (it->second == paramID) it = nrpnToParam.erase(it);
+            else ++it;
+        }
+    }
+
+    void handleParameterNumberCC(ChannelState& ch, int ccNumber, int value)
+    {
+        switch (ccNumber)
+        {
+            case 99: ch.nrpnMSB = value; break;
+            case 98: ch.nrpnLSB = value; break;
+            case 101: case 100: // RPN select deselects any NRPN
+                ch.nrpnMSB = ch.nrpnLSB = 127;
+                ch.selectedNRPN = -1;
+                return;
+            case 6:  ch.dataMSB = value; applyNRPN(ch, value << 7); return;
+            case 38: applyNRPN(ch, (ch.dataMSB << 7) | value); return;
+            default: return;
+        }
+
+        // 127/127 is the "null" parameter number
+        ch.selectedNRPN = (ch.nrpnMSB == 127 && ch.nrpnLSB == 127) ? -1 : ((ch.nrpnMSB << 7) | ch.nrpnLSB);
+        ch.resolvedGeneration = 0;
+    }
+
+    void applyNRPN(ChannelState& ch, int value14)
+    {
+        if (ch.selectedNRPN < 0) return;
+
+        if (isLearning.load())
+        {
+            commitLearn(kLearnNRPN, ch.selectedNRPN);
+            return;
+        }
+
+        audioThreadReading.store(true);
+        const auto* table = liveTable.load();
+        if (ch.resolvedGeneration != table->generation)
+        {
+            // Resolved once per selection (or table swap), data entry itself is O(1)
+            auto it = std::lower_bound(table->nrpn.begin(), table->nrpn.end(), ch.selectedNRPN,
+                                       [](const auto& e, int n) { return e.first < n; });
+            ch.nrpnTarget = (it != table->nrpn.end() && it->first == ch.selectedNRPN) ? it->second : nullptr;
+            ch.resolvedGeneration = table->generation;
+        }
+        setParameter(ch.nrpnTarget, value14 / 16383.0f);
+        audioThreadReading.store(false);
+    }
+
+    static void setParameter(juce::RangedAudioParameter* param, float normalizedValue)
+    {
+        // Dense controller streams often repeat values; skip the host round-trip
+        if (param != nullptr && param->getValue() != normalizedValue)
+            param->setValueNotifyingHost(normalizedValue);
+    }
+
+    /** Audio thread: records the learned controller, binding happens on the message thread */
+    void commitLearn(int type, int number)
+    {
+        if (!isLearning.exchange(false)) return;
+        learnedController.store((type << 16) | number);
+        triggerAsyncUpdate();
+    }
+
+    void handleAsyncUpdate() override
+    {
+        const int learned = learnedController.exchange(-1);
+        if (learned < 0 || learningParamID.isEmpty()) return;
+
+        const int type = learned >> 16;
+        const int number = learned & 0xFFFF;
+        auto result = juce::Result::ok();
+        if (type == kLearnNRPN) bindNRPN(number, learningParamID);
+        else result = bind(number, learningParamID, learnHighResolution);
+
+        learningParamID = "";
+        if (result.failed() && onMappingRejected) onMappingRejected(result.getErrorMessage());
+        if (onMappingChanged) onMappingChanged();
+    }
+
+    /** Message thread: compiles the mappings and publishes them to the audio thread */
+    void rebuildDispatchTable()
+    {
+        if (apvts == nullptr) return;
+
+        auto* current = liveTable.load();
+        auto* next = (current == &tables[0]) ? &tables[1] : &tables[0];
+
+        // The audio thread may still hold the table retired by the previous swap
+        while (audioThreadReading.load())
+            juce::Thread::yield();
+
+        next->cc.fill({});
+        for (auto const& [cc, id] : ccToParam)
+        {
+            auto* param = apvts->getParameter(id);
+            if (param == nullptr) continue;
+
+            if (isHighResolution(cc))
+            {
+                next->cc[static_cast<size_t>(cc)] = { param, EntryKind::CC14MSB };
+                next->cc[static_cast<size_t>(cc + 32)] = { param, EntryKind::CC14LSB };
+            }
+            else if (next->cc[static_cast<size_t>(cc)].kind == EntryKind::None)
+            {
+                next->cc[static_cast<size_t>(cc)] = { param, EntryKind::CC7 };
+            }
+        }
+
+        next->nrpn.clear();
+        for (auto const& [nrpn, id] : nrpnToParam)
+            if (auto* param = apvts->getParameter(id))
+                next->nrpn.emplace_back(nrpn, param); // std::map iterates in sorted order
+
+        next->generation = current->generation + 1;
+        liveTable.store(next);
+    }
+
+    // Editable mappings (message thread)
     std::map<int, juce::String> ccToParam;
-    bool isLearning = false;
+    std::set<int> highResCCs;
+    std::map<int, juce::String> nrpnToParam;
+    juce::AudioProcessorValueTreeState* apvts = nullptr;
+
+    // Published table (double-buffered, swapped atomically)
+    std::array<DispatchTable, 2> tables;
+    std::atomic<DispatchTable*> liveTable { &tables[0] };
+    std::atomic<bool> audioThreadReading { false };
+
+    std::array<ChannelState, 16> channelStates;
+
+    // Learn mode
+    std::atomic<bool> isLearning { false };
+    std::atomic<int> learnedController { -1 };
+    bool learnHighResolution = false;
     juce::String learningParamID;
 };
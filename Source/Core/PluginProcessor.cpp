@@ -2,6 +2,55 @@
 #include <JuceHeader.h>
 #include "PluginEditor.h"
 #include "PresetManager.h"
+#include "JunoStateChunk.h"
+
+namespace
+{
+    // Patch (panel) fields of SynthParams from any source of parameter values
+    // in parameter units, by schema index: the APVTS, or a stored preset for a
+    // multitimbral part
+    template <typename Getter>
+    void readPatchParams(SynthParams& params, Getter&& getVal)
+    {
+        auto getBool = [&](JunoParams::Index index) { return getVal(index) > 0.5f; };
+        auto getInt = [&](JunoParams::Index index) { return static_cast<int>(getVal(index)); };
+
+        params.dcoRange = getInt(JunoParams::DcoRange);
+        params.sawOn = getBool(JunoParams::SawOn);
+        params.pulseOn = getBool(JunoParams::PulseOn);
+        params.pwmAmount = getVal(JunoParams::Pwm);
+        params.pwmMode = getInt(JunoParams::PwmMode);
+        params.subOscLevel = getVal(JunoParams::SubOsc);
+        params.noiseLevel = getVal(JunoParams::Noise);
+        params.lfoToDCO = getVal(JunoParams::LfoToDCO);
+        params.hpfFreq = getInt(JunoParams::HpfFreq);
+        params.vcfFreq = getVal(JunoParams::VcfFreq);
+        params.resonance = getVal(JunoParams::Resonance);
+        params.envAmount = getVal(JunoParams::EnvAmount);
+        params.lfoToVCF = getVal(JunoParams::LfoToVCF);
+        params.kybdTracking = getVal(JunoParams::KybdTracking);
+        params.vcfPolarity = getInt(JunoParams::VcfPolarity);
+        params.vcaMode = getInt(JunoParams::VcaMode);
+        params.vcaLevel = getVal(JunoParams::VcaLevel);
+        params.attack = getVal(JunoParams::Attack);
+        params.decay = getVal(JunoParams::Decay);
+        params.sustain = getVal(JunoParams::Sustain);
+        params.release = getVal(JunoParams::Release);
+        params.lfoRate = getVal(JunoParams::LfoRate);
+        params.lfoDelay = getVal(JunoParams::LfoDelay);
+        params.chorus1 = getBool(JunoParams::Chorus1);
+        params.chorus2 = getBool(JunoParams::Chorus2);
+        params.polyMode = getInt(JunoParams::PolyMode);
+        params.portamentoTime = getVal(JunoParams::PortamentoTime);
+        params.portamentoOn = getBool(JunoParams::PortamentoOn);
+        params.benderToDCO = getVal(JunoParams::BenderToDCO);
+        params.benderToVCF = getVal(JunoParams::BenderToVCF);
+
+        // Mod Wheel (benderToLFO) is added to the LFO depths per sample in Voice
+        // from the modulation bus (Authentic feel: Modulation lever adds LFO)
+        params.vcfLFOAmount = params.lfoToVCF;
+    }
+}
 
 //==============================================================================
 SimpleJuno106AudioProcessor::SimpleJuno106AudioProcessor()
@@ -12,6 +61,9 @@ SimpleJuno106AudioProcessor::SimpleJuno106AudioProcessor()
                        .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
                       #endif
                        .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
+                       .withOutput ("Part 2", juce::AudioChannelSet::stereo(), false)
+                       .withOutput ("Part 3", juce::AudioChannelSet::stereo(), false)
+                       .withOutput ("Part 4", juce::AudioChannelSet::stereo(), false)
                      #endif
                        ),
 #else
@@ -19,10 +71,22 @@ SimpleJuno106AudioProcessor::SimpleJuno106AudioProcessor()
 #endif
       apvts(*this, nullptr, "Parameters", createParameterLayout())
 {
+    for (int i = 0; i < JunoParams::NumParams; ++i) {
+        const auto* id = JunoParams::kSpecs[(size_t)i].id;
+        rawParams[(size_t)i] = apvts.getRawParameterValue(id);
+        paramObjects[(size_t)i] = apvts.getParameter(id);
+    }
+    
     presetManager = std::make_unique<PresetManager>();
+    voiceManager.setModulationBus(&modBus);
+    voiceManager.setRenderPool(&renderPool);
+    for (auto& pending : pendingHostMirror) pending.store(kNoPendingMirror);
+    for (auto& pending : pendingPartProgram) pending.store(kNoPendingProgram);
+    for (auto& ready : partPatchReady) ready.store(false);
     // voiceTimestamp init removed
 
     // Default MIDI CC Mapping
+    midiLearnHandler.attachTo(apvts);
     midiLearnHandler.bind(16, "lfoRate");
     midiLearnHandler.bind(17, "lfoDelay");
     midiLearnHandler.bind(18, "lfoToDCO");
@@ -47,6 +111,7 @@ SimpleJuno106AudioProcessor::SimpleJuno106AudioProcessor()
 
 SimpleJuno106AudioProcessor::~SimpleJuno106AudioProcessor()
 {
+    cancelPendingUpdate();
 }
 
 //==============================================================================
@@ -65,33 +130,67 @@ void SimpleJuno106AudioProcessor::changeProgramName (int index, const juce::Stri
 //==============================================================================
 void SimpleJuno106AudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    voiceManager.prepare(sampleRate, samplesPerBlock);
+    hostSampleRate = sampleRate;
+    hostBlockSize = juce::jmax(1, samplesPerBlock);
+    cpuGovernor.prepare(sampleRate);
+    renderPool.start(static_cast<int>(getParam(JunoParams::RenderThreads)));
+    voiceBus.setSize(JunoVoiceManager::MAX_PARTS, samplesPerBlock * JunoOversampler::kMaxFactor);
+    chunkMidi.ensureSize(kChunkMidiBytes);
+    chunkMidiOut.ensureSize(kChunkMidiBytes);
+    updateOversampling(true);
+    modBus.prepare(sampleRate, samplesPerBlock);
+    
+    // Host parameter changes are ignored for 250ms after MIDI moved a controller
+    // (they are our own lazy mirror echoing back)
+    midiModHoldLength = static_cast<int>(sampleRate * 0.25);
+    for (int s = 0; s < JunoModulationBus::NumSources; ++s) {
+        lastHostModValue[(size_t)s] = getParam(getModulationParam(s));
+        midiModHoldSamples[(size_t)s] = 0;
+        modBus.addEvent(static_cast<JunoModulationBus::Source>(s), 0, lastHostModValue[(size_t)s]);
+    }
     
     juce::dsp::ProcessSpec spec;
     spec.sampleRate = sampleRate;
     spec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock);
     spec.numChannels = 2;
     
-    chorus.prepare(spec);
-    chorus.reset();
+    chorus.prepare(sampleRate, samplesPerBlock);
     
     dcBlocker.prepare(spec);
     *dcBlocker.state = *juce::dsp::IIR::Coefficients<float>::makeHighPass(sampleRate, 20.0f);
 }
 
-void SimpleJuno106AudioProcessor::releaseResources() {}
+void SimpleJuno106AudioProcessor::releaseResources()
+{
+    renderPool.stop();
+}
 
 bool SimpleJuno106AudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
 {
     if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
      && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
         return false;
+    
+    // Part outputs: off, mono or stereo
+    for (int i = 1; i < layouts.outputBuses.size(); ++i)
+    {
+        const auto& set = layouts.outputBuses.getReference(i);
+        if (!set.isDisabled() && set != juce::AudioChannelSet::mono() && set != juce::AudioChannelSet::stereo())
+            return false;
+    }
     return true;
 }
 
 void SimpleJuno106AudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    if (buffer.getNumSamples() > hostBlockSize)
+    {
+        processOversizedBlock(buffer, midiMessages);
+        return;
+    }
+    
     juce::ScopedNoDenormals noDenormals;
+    const auto renderStartTicks = juce::Time::getHighResolutionTicks();
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
@@ -102,6 +201,7 @@ void SimpleJuno106AudioProcessor::processBlock (juce::AudioBuffer<float>& buffer
     keyboardState.processNextMidiBuffer (midiMessages, 0, buffer.getNumSamples(), true);
 
     // 2. Handle SysEx and CCs (Directly from midiBuffer to avoid overhead in callbacks)
+    syncModulationFromHost(buffer.getNumSamples());
     for (const auto metadata : midiMessages)
     {
         auto message = metadata.getMessage();
@@ -122,57 +222,104 @@ void SimpleJuno106AudioProcessor::processBlock (juce::AudioBuffer<float>& buffer
             
             if (cn == 1) // Modulation
             {
-                if (auto* p = apvts.getParameter("benderToLFO")) p->setValueNotifyingHost(cv / 127.0f);
+                queueMidiModulation(JunoModulationBus::ModWheel, metadata.samplePosition, cv / 127.0f);
             }
             else if (cn == 64) // Sustain
             {
                 sustainPedalActive = (cv >= 64);
                 if (!sustainPedalActive)
                 {
-                    for (int note : pendingNoteOffs) handleNoteOff(nullptr, 0, note, 0.0f);
+                    for (int held : pendingNoteOffs) handleNoteOff(nullptr, held >> 7, held & 127, 0.0f);
                     pendingNoteOffs.clear();
                 }
             }
             else
             {
-                midiLearnHandler.handleIncomingCC(cn, cv, apvts);
+                midiLearnHandler.handleIncomingCC(message.getChannel(), cn, cv);
+            }
+        }
+        else if (message.isProgramChange())
+        {
+            // Parts 2..4 load their patch on the message thread
+            int part = getPartForChannel(message.getChannel());
+            if (part > 0)
+            {
+                pendingPartProgram[(size_t)part].store(message.getProgramChangeNumber());
+                triggerAsyncUpdate();
             }
         }
         else if (message.isPitchWheel())
         {
             auto val = (float)message.getPitchWheelValue();
             // Map 0-16383 to -1 to 1
-            float norm = (val / 8192.0f) - 1.0f;
-            if (auto* p = apvts.getParameter("bender")) p->setValueNotifyingHost(p->convertTo0to1(norm));
+            float norm = juce::jlimit(-1.0f, 1.0f, (val / 8192.0f) - 1.0f);
+            queueMidiModulation(JunoModulationBus::Bender, metadata.samplePosition, norm);
         }
     }
 
     // 3. Update internal parameters
+    modBus.render(buffer.getNumSamples());
     updateParamsFromAPVTS();
+    updateOversampling();
+    voiceManager.setTailCulling(cpuGovernor.useTailCulling());
     voiceManager.updateParams(currentParams);
+    updatePartsFromPanel();
 
-    // 4. Render voices
+    // 4. Render voices into the part buses at the oversampled rate, then decimate once per part
+    const int numSamples = buffer.getNumSamples();
+    const int numVoiceSamples = numSamples * oversamplers[0].getFactor();
+    jassert(numVoiceSamples <= voiceBus.getNumSamples());   // Sized for the top tier in prepareToPlay
+    
+    juce::AudioBuffer<float> partBuses(voiceBus.getArrayOfWritePointers(), numParts, numVoiceSamples);
+    partBuses.clear();
+    voiceManager.renderNextBlock(partBuses, 0, numVoiceSamples);
+    
+    auto mainOut = getBusBuffer(buffer, false, 0);
     buffer.clear();
-    voiceManager.renderNextBlock(buffer, 0, buffer.getNumSamples());
-
-    // 5. Apply Effects
-    juce::dsp::AudioBlock<float> block(buffer);
-    juce::dsp::ProcessContextReplacing<float> context(block);
     
-    bool c1 = apvts.getRawParameterValue("chorus1")->load() > 0.5f;
-    bool c2 = apvts.getRawParameterValue("chorus2")->load() > 0.5f;
-    
-    if (c1 || c2) {
-         if (c1 && !c2) {
-            chorus.setRate(0.5f); chorus.setDepth(0.12f); chorus.setMix(0.5f); chorus.setCentreDelay(6.0f);
-         } else if (!c1 && c2) {
-            chorus.setRate(0.8f); chorus.setDepth(0.25f); chorus.setMix(0.5f); chorus.setCentreDelay(8.0f);
-         } else {
-            chorus.setRate(1.0f); chorus.setDepth(0.15f); chorus.setMix(0.5f); chorus.setCentreDelay(7.0f);
-         }
-         chorus.process(context);
+    // Effect settings for this block
+    bool c1 = getParam(JunoParams::Chorus1) > 0.5f;
+    bool c2 = getParam(JunoParams::Chorus2) > 0.5f;
+    
+    // Mode changes crossfade inside the chorus; Off bypasses once faded out
+    chorus.setMode((c1 ? JunoChorus::ChorusI : 0) + (c2 ? JunoChorus::ChorusII : 0));
+    chorus.setEconomy(cpuGovernor.useChorusEconomy());
+    
+    const float outputDrive = getParam(JunoParams::OutputDrive);
+    if (outputDrive > 0.0f && !outputStageActive)
+        for (auto& stage : outputStage) stage.reset();
+    outputStageActive = outputDrive > 0.0f;
+    
+    // 5. Decimate, mix and apply effects in fixed sub-blocks, so each stage
+    //    picks up the previous one's output while it is still in cache
+    const int factor = oversamplers[0].getFactor();
+    for (int pos = 0; pos < numSamples; pos += kSubBlockSize)
+    {
+        const int subBlockSize = juce::jmin(kSubBlockSize, numSamples - pos);
+        
+        // Parts go to their own output when it is enabled, otherwise to the main mix
+        for (int part = 0; part < numParts; ++part)
+        {
+            oversamplers[(size_t)part].decimate(partBuses.getWritePointer(part, pos * factor), subBlockSize);
+            
+            auto addPart = [&](juce::AudioBuffer<float>& out) {
+                for (int ch = 0; ch < juce::jmin(2, out.getNumChannels()); ++ch)
+                    out.addFrom(ch, pos, partBuses, part, pos * factor, subBlockSize);
+            };
+            
+            if (part > 0 && part < getBusCount(false) && getBus(false, part)->isEnabled())
+            {
+                auto partOut = getBusBuffer(buffer, false, part);
+                addPart(partOut);
+            }
+            else
+            {
+                addPart(mainOut);
+            }
+        }
+        
+        processEffects(mainOut, pos, subBlockSize, outputDrive);
     }
-    dcBlocker.process(context);
 
     // 6. MIDI Out
     if (midiOutEnabled)
@@ -180,9 +327,234 @@ void SimpleJuno106AudioProcessor::processBlock (juce::AudioBuffer<float>& buffer
         midiMessages.addEvents(midiOutBuffer, 0, buffer.getNumSamples(), 0);
         midiOutBuffer.clear();
     }
+
+    // 7. CPU governor (offline renders are never degraded)
+    if (isNonRealtime() || getParam(JunoParams::CpuGovernor) < 0.5f)
+    {
+        if (cpuGovernor.getTier() != JunoCpuGovernor::Full) cpuGovernor.reset();
+    }
+    else
+    {
+        auto elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - renderStartTicks);
+        cpuGovernor.update(elapsed, buffer.getNumSamples());
+    }
+}
+
+void SimpleJuno106AudioProcessor::processEffects(juce::AudioBuffer<float>& mainOut, int startSample, int numSamples, float outputDrive)
+{
+    const int numChannels = juce::jmin(2, mainOut.getNumChannels());
+    float* channels[2] = { mainOut.getWritePointer(0, startSample),
+                           numChannels > 1 ? mainOut.getWritePointer(1, startSample) : nullptr };
+    juce::AudioBuffer<float> view(channels, numChannels, numSamples);
+    
+    chorus.process(view, numSamples);
+    
+    juce::dsp::AudioBlock<float> block(view);
+    juce::dsp::ProcessContextReplacing<float> context(block);
+    dcBlocker.process(context);
+    
+    // Analog output stage: up to +18 dB into a soft clipper that tops out at
+    // 0 dBFS, anti-aliased by 2nd-order ADAA. 0 = bypassed
+    if (outputDrive > 0.0f)
+    {
+        const float preGain = juce::Decibels::decibelsToGain(outputDrive * 18.0f) / 1.5f;
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto& stage = outputStage[(size_t)ch];
+            for (int i = 0; i < numSamples; ++i)
+                channels[ch][i] = 1.5f * stage.process(channels[ch][i] * preGain);
+        }
+    }
 }
 
 //==============================================================================
+void SimpleJuno106AudioProcessor::processOversizedBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    // Each chunk is a regular block: its own MIDI (shifted to 0) and its MIDI out
+    // collected back at the chunk's position
+    const int totalSamples = buffer.getNumSamples();
+    chunkMidiOut.clear();
+    
+    for (int pos = 0; pos < totalSamples; pos += hostBlockSize)
+    {
+        const int chunkSize = juce::jmin(hostBlockSize, totalSamples - pos);
+        juce::AudioBuffer<float> chunk(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), pos, chunkSize);
+        
+        chunkMidi.clear();
+        chunkMidi.addEvents(midiMessages, pos, chunkSize, -pos);
+        processBlock(chunk, chunkMidi);
+        chunkMidiOut.addEvents(chunkMidi, 0, chunkSize, pos);
+    }
+    
+    midiMessages.swapWith(chunkMidiOut);
+    chunkMidiOut.clear();
+}
+
+void SimpleJuno106AudioProcessor::updateOversampling(bool force)
+{
+    // 1x / 2x / 4x; offline renders can always use the top tier
+    int factor = 1 << juce::jlimit(0, 2, static_cast<int>(getParam(JunoParams::Oversampling)));
+    if (isNonRealtime() && getParam(JunoParams::OfflineMaxQuality) > 0.5f)
+        factor = JunoOversampler::kMaxFactor;
+    factor = cpuGovernor.limitOversampling(factor);
+    
+    if (factor == oversamplers[0].getFactor() && !force)
+        return;
+    
+    // Buffers are sized for the top tier in prepareToPlay, so switching does not allocate
+    for (auto& oversampler : oversamplers)
+    {
+        oversampler.setFactor(factor);
+        oversampler.reset();
+    }
+    
+    // prepareToPlay does the full prepare; a switch while playing (parameter,
+    // governor tier, offline quality) only changes the voice rate, so sounding
+    // notes keep their phase, filter state and LFO
+    if (force)
+        voiceManager.prepare(hostSampleRate * factor, hostBlockSize * JunoOversampler::kMaxFactor);
+    else
+        voiceManager.setSampleRate(hostSampleRate * factor);
+    voiceManager.setOversamplingFactor(factor);
+}
+
+JunoParams::Index SimpleJuno106AudioProcessor::getModulationParam(int source)
+{
+    return source == JunoModulationBus::Bender ? JunoParams::Bender : JunoParams::BenderToLFO;
+}
+
+void SimpleJuno106AudioProcessor::syncModulationFromHost(int numSamples)
+{
+    // UI lever / host automation moved the parameter: feed it into the bus
+    for (int s = 0; s < JunoModulationBus::NumSources; ++s)
+    {
+        float hostValue = getParam(getModulationParam(s));
+        
+        if (midiModHoldSamples[(size_t)s] > 0)
+            midiModHoldSamples[(size_t)s] -= numSamples;
+        else if (hostValue != lastHostModValue[(size_t)s])
+            modBus.addEvent(static_cast<JunoModulationBus::Source>(s), 0, hostValue);
+        
+        lastHostModValue[(size_t)s] = hostValue;
+    }
+}
+
+void SimpleJuno106AudioProcessor::queueMidiModulation(JunoModulationBus::Source source, int samplePosition, float value)
+{
+    modBus.addEvent(source, samplePosition, value);
+    midiModHoldSamples[(size_t)source] = midiModHoldLength;
+    pendingHostMirror[(size_t)source].store(value);
+    triggerAsyncUpdate();
+}
+
+void SimpleJuno106AudioProcessor::handleAsyncUpdate()
+{
+    // Message thread: mirror the latest MIDI controller values to the host (UI lever follows)
+    for (int s = 0; s < JunoModulationBus::NumSources; ++s)
+    {
+        float value = pendingHostMirror[(size_t)s].exchange(kNoPendingMirror);
+        if (value == kNoPendingMirror) continue;
+        
+        setParamValue(getModulationParam(s), value);
+    }
+    
+    // Program Change for a part: preset of the active bank -> the part's mailbox
+    const juce::ScopedLock partLock(partStateLock);
+    for (int part = 1; part < JunoVoiceManager::MAX_PARTS; ++part)
+    {
+        if (partPatchReady[(size_t)part].load(std::memory_order_acquire))
+        {
+            // Audio thread has not taken the previous patch yet: try again later
+            if (pendingPartProgram[(size_t)part].load() != kNoPendingProgram || partRestorePending[(size_t)part])
+                triggerAsyncUpdate();
+            continue;
+        }
+        
+        // Restored session: the part's stored patch goes first
+        if (partRestorePending[(size_t)part])
+        {
+            partRestorePending[(size_t)part] = false;
+            const auto& values = partPatchValues[(size_t)part];
+            readPatchParams(partPatchMailbox[(size_t)part], [&](JunoParams::Index index) {
+                return index < JunoParams::NumPatchParams ? values[(size_t)index] : getParam(index);
+            });
+            partPatchReady[(size_t)part].store(true, std::memory_order_release);
+            if (pendingPartProgram[(size_t)part].load() != kNoPendingProgram) triggerAsyncUpdate();
+            continue;
+        }
+        
+        int program = pendingPartProgram[(size_t)part].exchange(kNoPendingProgram);
+        const auto* preset = (program != kNoPendingProgram && presetManager) ? presetManager->getPreset(program) : nullptr;
+        if (preset == nullptr) continue;
+        
+        readPatchParams(partPatchMailbox[(size_t)part], [&](JunoParams::Index index) {
+            return preset->getValue(index, getParam(index));
+        });
+        partPatchReady[(size_t)part].store(true, std::memory_order_release);
+        
+        for (int i = 0; i < JunoParams::NumPatchParams; ++i)
+            partPatchValues[(size_t)part][(size_t)i] = preset->getValue(static_cast<JunoParams::Index>(i), getParam(static_cast<JunoParams::Index>(i)));
+        partPatchStored[(size_t)part] = true;
+    }
+}
+
+void SimpleJuno106AudioProcessor::storePanelToPart(int part)
+{
+    if (part <= 0 || part >= JunoVoiceManager::MAX_PARTS || partPatchReady[(size_t)part].load(std::memory_order_acquire))
+        return;
+    
+    readPatchParams(partPatchMailbox[(size_t)part], [this](JunoParams::Index index) { return getParam(index); });
+    partPatchReady[(size_t)part].store(true, std::memory_order_release);
+    
+    const juce::ScopedLock partLock(partStateLock);
+    partPatchValues[(size_t)part] = getPanelPatch();
+    partPatchStored[(size_t)part] = true;
+}
+
+int SimpleJuno106AudioProcessor::getPartForChannel(int channel) const
+{
+    // Single part: omni, as before
+    if (numParts <= 1) return 0;
+    
+    for (int part = 0; part < numParts; ++part)
+        if (((midiChannel - 1 + part) % 16) + 1 == channel) return part;
+    return -1;
+}
+
+void SimpleJuno106AudioProcessor::updatePartsFromPanel()
+{
+    const int previousParts = numParts;
+    numParts = static_cast<int>(getParam(JunoParams::Parts));
+    voiceManager.setNumParts(numParts);
+    
+    // Newly enabled parts start from the panel until they get a Program Change
+    for (int part = juce::jmax(1, previousParts); part < numParts; ++part)
+        partPatches[(size_t)part] = currentParams;
+    voiceManager.setPartReserve(static_cast<int>(getParam(JunoParams::PartReserve)));
+    
+    for (int part = 1; part < numParts; ++part)
+    {
+        auto& patch = partPatches[(size_t)part];
+        if (partPatchReady[(size_t)part].load(std::memory_order_acquire))
+        {
+            patch = partPatchMailbox[(size_t)part];
+            partPatchReady[(size_t)part].store(false, std::memory_order_release);
+        }
+        
+        // Engine-wide settings and performance controllers follow the panel
+        patch.benderValue = currentParams.benderValue;
+        patch.benderToLFO = currentParams.benderToLFO;
+        patch.tune = currentParams.tune;
+        patch.drift = currentParams.drift;
+        patch.controlRateMs = currentParams.controlRateMs;
+        patch.tailFloorDb = currentParams.tailFloorDb;
+        patch.numVoices = currentParams.numVoices;
+        
+        voiceManager.setPolyMode(patch.polyMode, part);
+        voiceManager.updatePartParams(part, patch);
+    }
+}
+
 void SimpleJuno106AudioProcessor::enterTestMode(bool enter)
 {
     isTestMode = enter;
@@ -251,124 +623,85 @@ void SimpleJuno106AudioProcessor::triggerTestProgram(int bankIndex)
 
 void SimpleJuno106AudioProcessor::handleNoteOn(juce::MidiKeyboardState*, int midiChannel, int midiNoteNumber, float velocity)
 {
-    voiceManager.noteOn(midiChannel, midiNoteNumber, velocity);
+    int part = getPartForChannel(midiChannel);
+    if (part >= 0)
+        voiceManager.noteOn(part, midiNoteNumber, velocity);
 }
 
 void SimpleJuno106AudioProcessor::handleNoteOff(juce::MidiKeyboardState*, int midiChannel, int midiNoteNumber, float velocity)
 {
     if (sustainPedalActive)
     {
-        if (std::find(pendingNoteOffs.begin(), pendingNoteOffs.end(), midiNoteNumber) == pendingNoteOffs.end())
-            pendingNoteOffs.push_back(midiNoteNumber);
+        // Held notes remember their channel (part) for the pedal release
+        int held = (midiChannel << 7) | midiNoteNumber;
+        if (std::find(pendingNoteOffs.begin(), pendingNoteOffs.end(), held) == pendingNoteOffs.end())
+            pendingNoteOffs.push_back(held);
         return;
     }
 
-    voiceManager.noteOff(midiChannel, midiNoteNumber, velocity);
+    int part = getPartForChannel(midiChannel);
+    if (part >= 0)
+        voiceManager.noteOff(part, midiNoteNumber, velocity);
 }
 
 void SimpleJuno106AudioProcessor::updateParamsFromAPVTS() {
-    auto getVal = [this](juce::String id) { return apvts.getRawParameterValue(id)->load(); };
-    auto getBool = [this](juce::String id) { return apvts.getRawParameterValue(id)->load() > 0.5f; };
-    auto getInt = [this](juce::String id) { return static_cast<int>(apvts.getRawParameterValue(id)->load()); };
-
-    currentParams.dcoRange = getInt("dcoRange");
-    currentParams.sawOn = getBool("sawOn");
-    currentParams.pulseOn = getBool("pulseOn");
-    currentParams.pwmAmount = getVal("pwm");
-    currentParams.pwmMode = getInt("pwmMode");
-    currentParams.subOscLevel = getVal("subOsc");
-    currentParams.noiseLevel = getVal("noise");
-    currentParams.lfoToDCO = getVal("lfoToDCO");
-    currentParams.hpfFreq = getInt("hpfFreq");
-    currentParams.vcfFreq = getVal("vcfFreq");
-    currentParams.resonance = getVal("resonance");
-    currentParams.envAmount = getVal("envAmount");
-    currentParams.lfoToVCF = getVal("lfoToVCF");
-    currentParams.kybdTracking = getVal("kybdTracking");
-    currentParams.vcfPolarity = getInt("vcfPolarity");
-    currentParams.vcaMode = getInt("vcaMode");
-    currentParams.vcaLevel = getVal("vcaLevel");
-    currentParams.attack = getVal("attack");
-    currentParams.decay = getVal("decay");
-    currentParams.sustain = getVal("sustain");
-    currentParams.release = getVal("release");
-    currentParams.lfoRate = getVal("lfoRate");
-    currentParams.lfoDelay = getVal("lfoDelay");
-    currentParams.chorus1 = getBool("chorus1");
-    currentParams.chorus2 = getBool("chorus2");
-    currentParams.polyMode = getInt("polyMode");
+    readPatchParams(currentParams, [this](JunoParams::Index index) { return getParam(index); });
+    currentParams.numVoices = static_cast<int>(getParam(JunoParams::Voices));
     voiceManager.setPolyMode(currentParams.polyMode);
 
-    currentParams.portamentoTime = getVal("portamentoTime");
-    currentParams.portamentoOn = getBool("portamentoOn");
-    currentParams.benderValue = getVal("bender");
-    currentParams.benderToDCO = getVal("benderToDCO");
-    currentParams.benderToVCF = getVal("benderToVCF");
-    
-    // Add Mod Wheel (benderToLFO) to LFO depths (Authentic feel: Modulation lever adds LFO)
-    float modWheel = getVal("benderToLFO");
-    currentParams.lfoToDCO = juce::jlimit(0.0f, 1.0f, getVal("lfoToDCO") + modWheel);
-    currentParams.vcfLFOAmount = juce::jlimit(0.0f, 1.0f, getVal("lfoToVCF") + modWheel);
+    currentParams.benderValue = modBus.getValue(JunoModulationBus::Bender);
+    currentParams.benderToLFO = modBus.getValue(JunoModulationBus::ModWheel);
 
-    currentParams.tune = getVal("tune");
+    currentParams.tune = getParam(JunoParams::Tune);
+    currentParams.drift = getParam(JunoParams::Drift);
+    currentParams.controlRateMs = cpuGovernor.limitControlRate(static_cast<int>(getParam(JunoParams::CtrlRate)));
+    currentParams.tailFloorDb = getParam(JunoParams::TailFloor);
 
-    midiOutEnabled = getBool("midiOut");
+    midiOutEnabled = getParam(JunoParams::MidiOut) > 0.5f;
 
-    // Detect changes and send SysEx (individual params 0x32)
+    // Detect changes and send SysEx (individual params 0x32, encoded like the dump)
     if (midiOutEnabled)
     {
-        auto sendIfChanged = [&](float oldVal, float newVal, JunoSysEx::ParamID pId) {
-            if (std::abs(oldVal - newVal) > 0.001f)
-                midiOutBuffer.addEvent(JunoSysEx::createParamChange(midiChannel - 1, pId, static_cast<int>(newVal * 127.0f)), 0);
-        };
-
-        sendIfChanged(lastParams.lfoRate, currentParams.lfoRate, JunoSysEx::LFO_RATE);
-        sendIfChanged(lastParams.lfoDelay, currentParams.lfoDelay, JunoSysEx::LFO_DELAY);
-        sendIfChanged(lastParams.lfoToDCO, currentParams.lfoToDCO, JunoSysEx::DCO_LFO);
-        sendIfChanged(lastParams.pwmAmount, currentParams.pwmAmount, JunoSysEx::DCO_PWM);
-        sendIfChanged(lastParams.noiseLevel, currentParams.noiseLevel, JunoSysEx::DCO_NOISE);
-        sendIfChanged(lastParams.vcfFreq, currentParams.vcfFreq, JunoSysEx::VCF_FREQ);
-        sendIfChanged(lastParams.resonance, currentParams.resonance, JunoSysEx::VCF_RES);
-        sendIfChanged(lastParams.envAmount, currentParams.envAmount, JunoSysEx::VCF_ENV);
-        sendIfChanged(lastParams.lfoToVCF, currentParams.lfoToVCF, JunoSysEx::VCF_LFO);
-        sendIfChanged(lastParams.kybdTracking, currentParams.kybdTracking, JunoSysEx::VCF_KYBD);
-        sendIfChanged(lastParams.vcaLevel, currentParams.vcaLevel, JunoSysEx::VCA_LEVEL);
-        sendIfChanged(lastParams.attack, currentParams.attack, JunoSysEx::ENV_A);
-        sendIfChanged(lastParams.decay, currentParams.decay, JunoSysEx::ENV_D);
-        sendIfChanged(lastParams.sustain, currentParams.sustain, JunoSysEx::ENV_S);
-        sendIfChanged(lastParams.release, currentParams.release, JunoSysEx::ENV_R);
-        sendIfChanged(lastParams.subOscLevel, currentParams.subOscLevel, JunoSysEx::DCO_SUB);
-
-        // SW1 (Byte 17)
-        uint8_t sw1 = 0;
-        if (currentParams.dcoRange == 0) sw1 |= (1 << 0);
-        if (currentParams.dcoRange == 1) sw1 |= (1 << 1);
-        if (currentParams.dcoRange == 2) sw1 |= (1 << 2);
-        if (currentParams.pulseOn) sw1 |= (1 << 3);
-        if (currentParams.sawOn) sw1 |= (1 << 4);
-        if (!(currentParams.chorus1 || currentParams.chorus2)) sw1 |= (1 << 5); 
-        if (currentParams.chorus1) sw1 |= (1 << 6); 
-
-        midiOutBuffer.addEvent(JunoSysEx::createParamChange(midiChannel - 1, JunoSysEx::SWITCHES_1, sw1), 0);
-
-        // SW2 (Byte 18)
-        uint8_t sw2 = 0;
-        if (currentParams.pwmMode == 1) sw2 |= (1 << 0);
-        if (currentParams.vcfPolarity == 1) sw2 |= (1 << 1);
-        if (currentParams.vcaMode == 1) sw2 |= (1 << 2);
-        
-        int hpfVal = currentParams.hpfFreq;
-        sw2 |= (static_cast<uint8_t>(hpfVal & 0x03) << 3);
+        const auto panel = getPanelPatch();
+        uint8_t patch[18], lastPatch[18];
+        JunoSysEx::encodePatch(panel, patch);
+        JunoSysEx::encodePatch(lastSentPatch, lastPatch);
+
+        for (int i = 0; i < 18; ++i)
+            if (!lastSentPatchValid || patch[i] != lastPatch[i])
+                midiOutBuffer.addEvent(JunoSysEx::createParamChange(midiChannel - 1, i, patch[i]), 0);
 
-        midiOutBuffer.addEvent(JunoSysEx::createParamChange(midiChannel - 1, JunoSysEx::SWITCHES_2, sw2), 0);
+        lastSentPatch = panel;
+        lastSentPatchValid = true;
     }
-    lastParams = currentParams;
+}
+
+JunoSysEx::PatchValues SimpleJuno106AudioProcessor::getPanelPatch() const {
+    JunoSysEx::PatchValues values {};
+    for (int i = 0; i < JunoParams::NumPatchParams; ++i)
+        values[(size_t)i] = getParam(static_cast<JunoParams::Index>(i));
+    return values;
+}
+
+void SimpleJuno106AudioProcessor::setPanelPatch(const JunoSysEx::PatchValues& values, int first, int last) {
+    for (int i = first; i < last; ++i)
+        setParamValue(static_cast<JunoParams::Index>(i), values[(size_t)i]);
+}
+
+void SimpleJuno106AudioProcessor::setParamValue(JunoParams::Index index, float value) {
+    if (auto* p = paramObjects[(size_t)index])
+        p->setValueNotifyingHost(p->convertTo0to1(value));
 }
 
 void SimpleJuno106AudioProcessor::loadPreset(int index) {
     if (!presetManager) return;
     const auto* preset = presetManager->getPreset(index);
-    if (preset != nullptr) {
+    if (preset != nullptr && preset->isPatch) {
+        // Decoded Juno patch: plain values, no ValueTree round trip
+        setPanelPatch(preset->values);
+        presetManager->setCurrentPreset(index);
+    }
+    else if (preset != nullptr) {
         for (int i = 0; i < (int)preset->state.getNumProperties(); ++i) {
             auto propName = preset->state.getPropertyName(i);
             auto value = preset->state.getProperty(propName);
@@ -394,88 +727,29 @@ void SimpleJuno106AudioProcessor::handleSysEx(const uint8_t* data, int size)
     
     if (JunoSysEx::parseMessage(msg, type, ch, p1, p2, dumpData))
     {
-        auto setParam = [&](juce::String id, float normVal) {
-            if (auto* p = apvts.getParameter(id)) p->setValueNotifyingHost(normVal);
-        };
-
         if (type == JunoSysEx::kMsgParamChange)
         {
-            float fVal = p2 / 127.0f;
-            switch (p1)
+            // Sliders: the SysEx parameter number is the schema index
+            if (p1 < JunoParams::NumPatchSliders)
             {
-                case JunoSysEx::LFO_RATE: setParam("lfoRate", fVal); break;
-                case JunoSysEx::LFO_DELAY: setParam("lfoDelay", fVal); break;
-                case JunoSysEx::DCO_LFO: setParam("lfoToDCO", fVal); break;
-                case JunoSysEx::DCO_PWM: setParam("pwm", fVal); break;
-                case JunoSysEx::DCO_NOISE: setParam("noise", fVal); break;
-                case JunoSysEx::VCF_FREQ: setParam("vcfFreq", fVal); break;
-                case JunoSysEx::VCF_RES: setParam("resonance", fVal); break;
-                case JunoSysEx::VCF_ENV: setParam("envAmount", fVal); break;
-                case JunoSysEx::VCF_LFO: setParam("lfoToVCF", fVal); break;
-                case JunoSysEx::VCF_KYBD: setParam("kybdTracking", fVal); break;
-                case JunoSysEx::VCA_LEVEL: setParam("vcaLevel", fVal); break;
-                case JunoSysEx::ENV_A: setParam("attack", fVal); break;
-                case JunoSysEx::ENV_D: setParam("decay", fVal); break;
-                case JunoSysEx::ENV_S: setParam("sustain", fVal); break;
-                case JunoSysEx::ENV_R: setParam("release", fVal); break;
-                case JunoSysEx::DCO_SUB: setParam("subOsc", fVal); break;
-                
-                case JunoSysEx::SWITCHES_1:
-                {
-                    setParam("dcoRange", (p2 & 1) ? 0.0f : ((p2 & 2) ? 1.0f : 2.0f));
-                    setParam("pulseOn", (p2 & (1 << 3)) != 0);
-                    setParam("sawOn", (p2 & (1 << 4)) != 0);
-                    bool chorusOn = (p2 & (1 << 5)) == 0;
-                    bool chorusMode1 = (p2 & (1 << 6)) != 0;
-                    setParam("chorus1", chorusOn && chorusMode1);
-                    setParam("chorus2", chorusOn && !chorusMode1);
-                    break;
-                }
-                case JunoSysEx::SWITCHES_2:
-                {
-                    setParam("pwmMode", (p2 & (1 << 0)) != 0);
-                    setParam("vcaMode", (p2 & (1 << 1)) != 0);
-                    setParam("vcfPolarity", (p2 & (1 << 2)) != 0);
-                    int hpf = (p2 >> 3) & 0x03;
-                    setParam("hpfFreq", (float)hpf);
-                    break;
-                }
+                setParamValue(static_cast<JunoParams::Index>(p1), p2 / 127.0f);
+            }
+            else if (p1 == JunoSysEx::SWITCHES_1)
+            {
+                auto values = getPanelPatch();
+                JunoSysEx::decodeSwitches1(static_cast<uint8_t>(p2), values);
+                setPanelPatch(values, JunoParams::DcoRange, JunoParams::Chorus2 + 1);
+            }
+            else if (p1 == JunoSysEx::SWITCHES_2)
+            {
+                auto values = getPanelPatch();
+                JunoSysEx::decodeSwitches2(static_cast<uint8_t>(p2), values);
+                setPanelPatch(values, JunoParams::PwmMode, JunoParams::HpfFreq + 1);
             }
         }
         else if (type == JunoSysEx::kMsgPatchDump && dumpData.size() >= 18)
         {
-            setParam("lfoRate", dumpData[0] / 127.0f);
-            setParam("lfoDelay", dumpData[1] / 127.0f);
-            setParam("lfoToDCO", dumpData[2] / 127.0f);
-            setParam("pwm", dumpData[3] / 127.0f);
-            setParam("noise", dumpData[4] / 127.0f);
-            setParam("vcfFreq", dumpData[5] / 127.0f);
-            setParam("resonance", dumpData[6] / 127.0f);
-            setParam("envAmount", dumpData[7] / 127.0f);
-            setParam("lfoToVCF", dumpData[8] / 127.0f);
-            setParam("kybdTracking", dumpData[9] / 127.0f);
-            setParam("vcaLevel", dumpData[10] / 127.0f);
-            setParam("attack", dumpData[11] / 127.0f);
-            setParam("decay", dumpData[12] / 127.0f);
-            setParam("sustain", dumpData[13] / 127.0f);
-            setParam("release", dumpData[14] / 127.0f);
-            setParam("subOsc", dumpData[15] / 127.0f);
-            
-            uint8_t sw1 = dumpData[16];
-            setParam("dcoRange", (sw1 & 1) ? 0.0f : ((sw1 & 2) ? 1.0f : 2.0f));
-            setParam("pulseOn", (sw1 & (1 << 3)) != 0);
-            setParam("sawOn", (sw1 & (1 << 4)) != 0);
-            bool chorusOn = (sw1 & (1 << 5)) == 0;
-            bool chorusMode1 = (sw1 & (1 << 6)) != 0;
-            setParam("chorus1", chorusOn && chorusMode1);
-            setParam("chorus2", chorusOn && !chorusMode1);
-
-            uint8_t sw2 = dumpData[17];
-            setParam("pwmMode", (sw2 & (1 << 0)) != 0);
-            setParam("vcaMode", (sw2 & (1 << 1)) != 0);
-            setParam("vcfPolarity", (sw2 & (1 << 2)) != 0);
-            int hpf = (sw2 >> 3) & 0x03;
-            setParam("hpfFreq", (float)hpf);
+            setPanelPatch(JunoSysEx::decodePatch(dumpData.data()));
         }
     }
 }
@@ -487,86 +761,38 @@ void SimpleJuno106AudioProcessor::sendPatchDump()
 
 juce::MidiMessage SimpleJuno106AudioProcessor::generatePatchDumpMessage()
 {
-    uint8_t params[16];
-    params[0] = static_cast<uint8_t>(currentParams.lfoRate * 127.0f);
-    params[1] = static_cast<uint8_t>(currentParams.lfoDelay * 127.0f);
-    params[2] = static_cast<uint8_t>(currentParams.lfoToDCO * 127.0f);
-    params[3] = static_cast<uint8_t>(currentParams.pwmAmount * 127.0f);
-    params[4] = static_cast<uint8_t>(currentParams.noiseLevel * 127.0f);
-    params[5] = static_cast<uint8_t>(currentParams.vcfFreq * 127.0f);
-    params[6] = static_cast<uint8_t>(currentParams.resonance * 127.0f);
-    params[7] = static_cast<uint8_t>(currentParams.envAmount * 127.0f);
-    params[8] = static_cast<uint8_t>(currentParams.lfoToVCF * 127.0f);
-    params[9] = static_cast<uint8_t>(currentParams.kybdTracking * 127.0f);
-    params[10] = static_cast<uint8_t>(currentParams.vcaLevel * 127.0f);
-    params[11] = static_cast<uint8_t>(currentParams.attack * 127.0f);
-    params[12] = static_cast<uint8_t>(currentParams.decay * 127.0f);
-    params[13] = static_cast<uint8_t>(currentParams.sustain * 127.0f);
-    params[14] = static_cast<uint8_t>(currentParams.release * 127.0f);
-    params[15] = static_cast<uint8_t>(currentParams.subOscLevel * 127.0f);
-
-    uint8_t sw1 = 0;
-    if (currentParams.dcoRange == 0) sw1 |= (1 << 0);
-    if (currentParams.dcoRange == 1) sw1 |= (1 << 1);
-    if (currentParams.dcoRange == 2) sw1 |= (1 << 2);
-    if (currentParams.pulseOn) sw1 |= (1 << 3);
-    if (currentParams.sawOn) sw1 |= (1 << 4);
-    if (!(currentParams.chorus1 || currentParams.chorus2)) sw1 |= (1 << 5); 
-    if (currentParams.chorus1) sw1 |= (1 << 6); 
-
-    uint8_t sw2 = 0;
-    if (currentParams.pwmMode == 1) sw2 |= (1 << 0);
-    if (currentParams.vcaMode == 1) sw2 |= (1 << 1);
-    if (currentParams.vcfPolarity == 1) sw2 |= (1 << 2);
-    
-    int hpfVal = currentParams.hpfFreq;
-    sw2 |= (static_cast<uint8_t>(hpfVal & 0x03) << 3);
-
-    return JunoSysEx::createPatchDump(midiChannel - 1, 0, params, sw1, sw2);
+    uint8_t patch[18];
+    JunoSysEx::encodePatch(getPanelPatch(), patch);
+    return JunoSysEx::createPatchDump(midiChannel - 1, 0, patch, patch[16], patch[17]);
 }
 
 PresetManager* SimpleJuno106AudioProcessor::getPresetManager() { return presetManager.get(); }
 
+// Schema limits that mirror engine constants
+static_assert(JunoParams::kSpecs[JunoParams::Voices].max == JunoVoiceManager::MAX_VOICES
+              && JunoParams::kSpecs[JunoParams::Voices].def == JunoVoiceManager::DEFAULT_VOICES
+              && JunoParams::kSpecs[JunoParams::Parts].max == JunoVoiceManager::MAX_PARTS
+              && JunoParams::kSpecs[JunoParams::RenderThreads].max == JunoRenderPool::kMaxWorkers,
+              "Parameter schema out of sync with the engine");
+
 juce::AudioProcessorValueTreeState::ParameterLayout SimpleJuno106AudioProcessor::createParameterLayout() {
     std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-    auto makeParam = [](juce::String id, juce::String name, float min, float max, float def) { return std::make_unique<juce::AudioParameterFloat>(id, name, min, max, def); };
-    auto makeIntParam = [](juce::String id, juce::String name, int min, int max, int def) { return std::make_unique<juce::AudioParameterInt>(id, name, min, max, def); };
-    auto makeBool = [](juce::String id, juce::String name, bool def) { return std::make_unique<juce::AudioParameterBool>(id, name, def); };
-
-    params.push_back(makeIntParam("dcoRange", "DCO Range", 0, 2, 1));
-    params.push_back(makeBool("sawOn", "DCO Saw", true));
-    params.push_back(makeBool("pulseOn", "DCO Pulse", false));
-    params.push_back(makeParam("pwm", "PWM Level", 0.0f, 1.0f, 0.0f));
-    params.push_back(makeIntParam("pwmMode", "PWM Mode", 0, 1, 0));
-    params.push_back(makeParam("subOsc", "Sub Osc Level", 0.0f, 1.0f, 0.0f));
-    params.push_back(makeParam("noise", "Noise Level", 0.0f, 1.0f, 0.0f));
-    params.push_back(makeParam("lfoToDCO", "LFO to DCO", 0.0f, 1.0f, 0.0f));
-    params.push_back(makeIntParam("hpfFreq", "HPF Freq", 0, 3, 0));
-    params.push_back(makeParam("vcfFreq", "VCF Freq", 0.0f, 1.0f, 1.0f));
-    params.push_back(makeParam("resonance", "Resonance", 0.0f, 1.0f, 0.0f));
-    params.push_back(makeParam("envAmount", "Env Amount", 0.0f, 1.0f, 0.0f));
-    params.push_back(makeIntParam("vcfPolarity", "VCF Polarity", 0, 1, 0));
-    params.push_back(makeParam("kybdTracking", "VCF Kykd Track", 0.0f, 1.0f, 0.0f));
-    params.push_back(makeParam("lfoToVCF", "LFO to VCF", 0.0f, 1.0f, 0.0f));
-    params.push_back(makeIntParam("vcaMode", "VCA Mode", 0, 1, 0));
-    params.push_back(makeParam("vcaLevel", "VCA Level", 0.0f, 1.0f, 1.0f));
-    params.push_back(makeParam("attack", "Attack", 0.0f, 1.0f, 0.0f));
-    params.push_back(makeParam("decay", "Decay", 0.0f, 1.0f, 0.0f));
-    params.push_back(makeParam("sustain", "Sustain", 0.0f, 1.0f, 1.0f));
-    params.push_back(makeParam("release", "Release", 0.0f, 1.0f, 0.0f));
-    params.push_back(makeParam("lfoRate", "LFO Rate", 0.0f, 1.0f, 0.5f));
-    params.push_back(makeParam("lfoDelay", "LFO Delay", 0.0f, 1.0f, 0.0f));
-    params.push_back(makeBool("chorus1", "Chorus I", false));
-    params.push_back(makeBool("chorus2", "Chorus II", false));
-    params.push_back(makeIntParam("polyMode", "Poly Mode", 1, 3, 1));
-    params.push_back(makeParam("portamentoTime", "Portamento Time", 0.0f, 1.0f, 0.0f));
-    params.push_back(makeBool("portamentoOn", "Portamento On", false));
-    params.push_back(makeParam("bender", "Bender", -1.0f, 1.0f, 0.0f));
-    params.push_back(makeParam("benderToDCO", "Bender to DCO", 0.0f, 1.0f, 0.0f));
-    params.push_back(makeParam("benderToVCF", "Bender to VCF", 0.0f, 1.0f, 0.0f));
-    params.push_back(makeParam("benderToLFO", "Bender to LFO", 0.0f, 1.0f, 0.0f));
-    params.push_back(makeParam("tune", "Master Tune", -50.0f, 50.0f, 0.0f));
-    params.push_back(makeBool("midiOut", "MIDI Out Enabled", false));
+    params.reserve(JunoParams::NumParams);
+    
+    for (const auto& spec : JunoParams::kSpecs) {
+        switch (spec.type) {
+            case JunoParams::Type::Float:
+                params.push_back(std::make_unique<juce::AudioParameterFloat>(spec.id, spec.name, spec.min, spec.max, spec.def));
+                break;
+            case JunoParams::Type::Int:
+                params.push_back(std::make_unique<juce::AudioParameterInt>(spec.id, spec.name, static_cast<int>(spec.min),
+                                                                           static_cast<int>(spec.max), static_cast<int>(spec.def)));
+                break;
+            case JunoParams::Type::Bool:
+                params.push_back(std::make_unique<juce::AudioParameterBool>(spec.id, spec.name, spec.def > 0.5f));
+                break;
+        }
+    }
 
     return { params.begin(), params.end() };
 }
@@ -580,14 +806,97 @@ juce::AudioProcessorEditor* SimpleJuno106AudioProcessor::createEditor() {
 }
 
 void SimpleJuno106AudioProcessor::getStateInformation(juce::MemoryBlock& destData) {
-    auto state = apvts.copyState();
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    copyXmlToBinary(*xml, destData);
+    // Versioned binary chunk (JunoStateChunk); sessions saved as XML still load
+    JunoStateChunk::Writer chunk(destData);
+    
+    chunk.addSection(JunoStateChunk::Parameters, [this](juce::OutputStream& out) {
+        out.writeInt(static_cast<int>(JunoStateChunk::kSchemaDigest));
+        out.writeShort(static_cast<short>(JunoParams::NumParams));
+        for (int i = 0; i < JunoParams::NumParams; ++i)
+            out.writeFloat(getParam(static_cast<JunoParams::Index>(i)));
+    });
+    chunk.addSection(JunoStateChunk::ParameterIDs, [](juce::OutputStream& out) {
+        for (const auto& spec : JunoParams::kSpecs) out.writeString(spec.id);
+    });
+    chunk.addSection(JunoStateChunk::MidiMappings, [this](juce::OutputStream& out) {
+        midiLearnHandler.writeMappings(out);
+    });
+    
+    if (presetManager) {
+        chunk.addSection(JunoStateChunk::PresetRef, [this](juce::OutputStream& out) {
+            const int bank = presetManager->getActiveBankIndex();
+            out.writeString(presetManager->getBank(bank).name);
+            out.writeInt(bank);
+            out.writeInt(presetManager->getCurrentPresetIndex());
+        });
+    }
+    
+    chunk.addSection(JunoStateChunk::Parts, [this](juce::OutputStream& out) {
+        const juce::ScopedLock partLock(partStateLock);
+        for (int part = 1; part < JunoVoiceManager::MAX_PARTS; ++part) {
+            out.writeByte(partPatchStored[(size_t)part] ? 1 : 0);
+            for (auto value : partPatchValues[(size_t)part]) out.writeFloat(value);
+        }
+    });
 }
 
 void SimpleJuno106AudioProcessor::setStateInformation(const void* data, int sizeInBytes) {
-    std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
-    if (xmlState != nullptr)
-        if (xmlState->hasTagName(apvts.state.getType().toString()))
-            apvts.replaceState(juce::ValueTree::fromXml(*xmlState));
+    JunoStateChunk::Reader chunk;
+    if (!chunk.parse(data, sizeInBytes)) {
+        // Sessions saved before the binary chunk: APVTS as XML
+        std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
+        if (xmlState != nullptr)
+            if (xmlState->hasTagName(apvts.state.getType().toString()))
+                apvts.replaceState(juce::ValueTree::fromXml(*xmlState));
+        return;
+    }
+    
+    // Version 1 is the first binary layout: no per-version fix-ups yet. Schema
+    // changes are handled by readParameters (by ID when the digest differs)
+    // One replaceState with the decoded values: the APVTS tree (user presets
+    // copy it), the raw values and the editor attachments all agree on return
+    std::array<float, JunoParams::NumParams> values;
+    if (chunk.readParameters(values)) {
+        auto state = apvts.copyState();
+        for (int i = 0; i < JunoParams::NumParams; ++i) {
+            auto param = state.getChildWithProperty("id", juce::String(JunoParams::getID(static_cast<JunoParams::Index>(i))));
+            if (param.isValid()) param.setProperty("value", values[(size_t)i], nullptr);
+        }
+        apvts.replaceState(state);
+    }
+    
+    if (const auto* section = chunk.find(JunoStateChunk::MidiMappings)) {
+        juce::MemoryInputStream in(section->data, section->size, false);
+        midiLearnHandler.readMappings(in);
+    }
+    
+    if (const auto* section = chunk.find(JunoStateChunk::PresetRef); section != nullptr && presetManager) {
+        juce::MemoryInputStream in(section->data, section->size, false);
+        const auto bankName = in.readString();
+        const int bank = in.readInt();
+        const int preset = in.readInt();
+        
+        // Tape banks are not stored: only a bank that is still there under its name
+        if (bank >= 0 && bank < presetManager->getNumBanks() && presetManager->getBank(bank).name == bankName) {
+            presetManager->selectBank(bank);
+            presetManager->setCurrentPreset(preset);
+        }
+    }
+    
+    if (const auto* section = chunk.find(JunoStateChunk::Parts)) {
+        juce::MemoryInputStream in(section->data, section->size, false);
+        const juce::ScopedLock partLock(partStateLock);
+        for (int part = 1; part < JunoVoiceManager::MAX_PARTS && !in.isExhausted(); ++part) {
+            const bool stored = in.readByte() != 0;
+            JunoSysEx::PatchValues patch {};
+            for (auto& value : patch) value = in.readFloat();
+            
+            if (stored) {
+                partPatchValues[(size_t)part] = patch;
+                partPatchStored[(size_t)part] = true;
+                partRestorePending[(size_t)part] = true;
+            }
+        }
+        triggerAsyncUpdate();
+    }
 }
@@ -4,8 +4,14 @@
 
 #include "../Synth/Voice.h"
 #include "JunoVoiceManager.h"
+#include "JunoParameters.h"
 #include "JunoSysEx.h"
 #include "MidiLearnHandler.h"
+#include "../Synth/JunoOversampler.h"
+#include "../Synth/JunoChorus.h"
+#include "../Synth/JunoSaturation.h"
+#include "JunoCpuGovernor.h"
+#include "JunoRenderPool.h"
 
 class PresetManager;
 
@@ -13,7 +19,8 @@ class PresetManager;
  * SimpleJuno106AudioProcessor
  */
 class SimpleJuno106AudioProcessor : public juce::AudioProcessor,
-                                     public juce::MidiKeyboardState::Listener {
+                                     public juce::MidiKeyboardState::Listener,
+                                     private juce::AsyncUpdater {
 public:
     SimpleJuno106AudioProcessor();
     ~SimpleJuno106AudioProcessor() override;
@@ -50,12 +57,16 @@ public:
     juce::AudioProcessorValueTreeState& getAPVTS() { return apvts; }
     class PresetManager* getPresetManager();
     const JunoVoiceManager& getVoiceManager() const { return voiceManager; }
+    const JunoCpuGovernor& getCpuGovernor() const { return cpuGovernor; }
     
     juce::MidiKeyboardState keyboardState;
 
     // Preset Management
     void loadPreset(int index);
     
+    // Multitimbral: copy the panel into a part's patch (message thread)
+    void storePanelToPart(int part);
+    
     // Internal Synth Logic
     void updateParamsFromAPVTS();
     
@@ -79,9 +90,21 @@ private:
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     
     // Core Engine
+    JunoRenderPool renderPool; // Voice render workers (started in prepareToPlay)
     JunoVoiceManager voiceManager;
     SynthParams currentParams;
-    SynthParams lastParams; // Used to detect changes for SysEx send
+    JunoSysEx::PatchValues lastSentPatch {}; // Used to detect changes for SysEx send
+    bool lastSentPatchValid = false;
+    
+    // Parameters by schema index (resolved once: no string lookups at run time)
+    std::array<std::atomic<float>*, JunoParams::NumParams> rawParams {};
+    std::array<juce::RangedAudioParameter*, JunoParams::NumParams> paramObjects {};
+    float getParam(JunoParams::Index index) const { return rawParams[(size_t)index]->load(); }
+    void setParamValue(JunoParams::Index index, float value); // Parameter units, notifies the host
+    
+    // Panel <-> patch (the first NumPatchParams parameters)
+    JunoSysEx::PatchValues getPanelPatch() const;
+    void setPanelPatch(const JunoSysEx::PatchValues& values, int first = 0, int last = JunoParams::NumPatchParams);
 
     std::unique_ptr<class PresetManager> presetManager;
     
@@ -89,8 +112,68 @@ private:
     bool sustainPedalActive = false;
     std::vector<int> pendingNoteOffs;
 
-    juce::dsp::Chorus<float> chorus; 
+    // Performance controllers (Bender / Modulation lever)
+    // MIDI drives the voices through the bus; host parameters are mirrored
+    // lazily on the message thread (handleAsyncUpdate).
+    JunoModulationBus modBus;
+    static constexpr float kNoPendingMirror = -1000.0f;
+    std::array<float, JunoModulationBus::NumSources> lastHostModValue {};
+    std::array<int, JunoModulationBus::NumSources> midiModHoldSamples {};
+    std::array<std::atomic<float>, JunoModulationBus::NumSources> pendingHostMirror;
+    int midiModHoldLength = 11025;
+
+    static JunoParams::Index getModulationParam(int source);
+    void syncModulationFromHost(int numSamples);
+    void queueMidiModulation(JunoModulationBus::Source source, int samplePosition, float value);
+    void handleAsyncUpdate() override;
+
+    // CPU-adaptive quality (measured per block)
+    JunoCpuGovernor cpuGovernor;
+
+    // Multitimbral parts: part 0 plays the panel, the others a stored patch
+    // (Program Change on their channel). Part p listens on basic channel + p.
+    // Patches reach the audio thread through a one-slot mailbox per part
+    int numParts = 1;
+    std::array<SynthParams, JunoVoiceManager::MAX_PARTS> partPatches;
+    std::array<SynthParams, JunoVoiceManager::MAX_PARTS> partPatchMailbox;
+    std::array<std::atomic<bool>, JunoVoiceManager::MAX_PARTS> partPatchReady;
+    std::array<std::atomic<int>, JunoVoiceManager::MAX_PARTS> pendingPartProgram;
+    static constexpr int kNoPendingProgram = -1;
+    
+    // Message-thread copy of each part's stored patch (saved with the state;
+    // a restored one is posted to the mailbox from handleAsyncUpdate). Hosts may
+    // save/restore state off the message thread: all access holds partStateLock
+    juce::CriticalSection partStateLock;
+    std::array<JunoSysEx::PatchValues, JunoVoiceManager::MAX_PARTS> partPatchValues {};
+    std::array<bool, JunoVoiceManager::MAX_PARTS> partPatchStored {};
+    std::array<bool, JunoVoiceManager::MAX_PARTS> partRestorePending {};
+    
+    int getPartForChannel(int channel) const;
+    void updatePartsFromPanel();
+    
+    // Voice bus (one mono channel per part, oversampled) and its decimators
+    std::array<JunoOversampler, JunoVoiceManager::MAX_PARTS> oversamplers;
+    juce::AudioBuffer<float> voiceBus;
+    double hostSampleRate = 44100.0;
+    int hostBlockSize = 512;
+    void updateOversampling(bool force = false);
+    
+    // Host blocks longer than prepared are rendered in prepared-size chunks,
+    // so nothing is resized on the audio thread
+    static constexpr int kChunkMidiBytes = 8192;
+    juce::MidiBuffer chunkMidi, chunkMidiOut;
+    void processOversizedBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages);
+
+    // Post-voice chain (decimation, part mix, effects) runs in the voices' sub-block size
+    static constexpr int kSubBlockSize = Voice::kSubBlockSize;
+    void processEffects(juce::AudioBuffer<float>& mainOut, int startSample, int numSamples, float outputDrive);
+    
+    JunoChorus chorus;
     juce::dsp::ProcessorDuplicator<juce::dsp::IIR::Filter<float>, juce::dsp::IIR::Coefficients<float>> dcBlocker;
+    
+    // Optional analog output stage (after the DC blocker)
+    std::array<JunoSaturation::ADAA2<JunoSaturation::SoftClip>, 2> outputStage;
+    bool outputStageActive = false;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SimpleJuno106AudioProcessor)
 };
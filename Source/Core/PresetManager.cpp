@@ -1,5 +1,5 @@
 #include "PresetManager.h"
-#include "FactoryPresets.h"
+#include "JunoSharedResources.h"
 #include "JunoTapeDecoder.h"
 
 PresetManager::PresetManager() {
@@ -9,6 +9,8 @@ PresetManager::PresetManager() {
     loadUserPresets();
 }
 
+PresetManager::~PresetManager() = default;
+
 void PresetManager::addBank(const juce::String& name) {
     Bank b;
     b.name = name;
@@ -73,83 +75,40 @@ void PresetManager::createFactoryPreset(Bank& bank, const juce::String& name,
 }
 
 PresetManager::Preset PresetManager::createPresetFromJunoBytes(const juce::String& name, const unsigned char* bytes) {
-    juce::ValueTree state("Parameters");
-    auto toNorm = [](unsigned char b) { return static_cast<float>(b) / 127.0f; };
-    
-    state.setProperty("lfoRate", toNorm(bytes[0]), nullptr);
-    state.setProperty("lfoDelay", toNorm(bytes[1]), nullptr);
-    state.setProperty("lfoToDCO", toNorm(bytes[2]), nullptr);
-    state.setProperty("pwm", toNorm(bytes[3]), nullptr);
-    state.setProperty("noise", toNorm(bytes[4]), nullptr);
-    state.setProperty("vcfFreq", toNorm(bytes[5]), nullptr);
-    state.setProperty("resonance", toNorm(bytes[6]), nullptr);
-    state.setProperty("envAmount", toNorm(bytes[7]), nullptr);
-    state.setProperty("lfoToVCF", toNorm(bytes[8]), nullptr);
-    state.setProperty("kybdTracking", toNorm(bytes[9]), nullptr);
-    state.setProperty("vcaLevel", toNorm(bytes[10]), nullptr);
-    state.setProperty("attack", toNorm(bytes[11]), nullptr);
-    state.setProperty("decay", toNorm(bytes[12]), nullptr);
-    state.setProperty("sustain", toNorm(bytes[13]), nullptr);
-    state.setProperty("release", toNorm(bytes[14]), nullptr);
-    state.setProperty("subOsc", toNorm(bytes[15]), nullptr);
-    
-    unsigned char sw1 = bytes[16];
-    int range = 1; 
-    if (sw1 & (1 << 0)) range = 0; // 16'
-    else if (sw1 & (1 << 1)) range = 1; // 8'
-    else if (sw1 & (1 << 2)) range = 2; // 4'
-    state.setProperty("dcoRange", range, nullptr);
-    state.setProperty("pulseOn", (sw1 & (1 << 3)) != 0, nullptr);
-    state.setProperty("sawOn", (sw1 & (1 << 4)) != 0, nullptr);
-    
-    bool chorusOn = (sw1 & (1 << 5)) == 0;
-    bool chorusModeII = (sw1 & (1 << 6)) != 0; // 0=I, 1=II
-    state.setProperty("chorus1", chorusOn && !chorusModeII, nullptr);
-    state.setProperty("chorus2", chorusOn && chorusModeII, nullptr);
-
-    unsigned char sw2 = bytes[17];
-    state.setProperty("pwmMode", (sw2 & (1 << 0)) != 0, nullptr);
-    state.setProperty("vcfPolarity", (sw2 & (1 << 1)) != 0, nullptr);
-    state.setProperty("vcaMode", (sw2 & (1 << 2)) != 0, nullptr);
-    
-    int hpfRaw = (sw2 >> 3) & 0x03;
-    state.setProperty("hpfFreq", hpfRaw, nullptr); // Map 1:1
-    
-    return Preset(name, "Factory", state);
+    return Preset(name, "Factory", JunoSysEx::decodePatch(bytes));
 }
 
-void PresetManager::loadFactoryPresets() {
-    Bank& bank = banks[0];
-    bank.patches.clear();
+float PresetManager::Preset::getValue(JunoParams::Index index, float fallback) const {
+    if (isPatch)
+        return index < JunoParams::NumPatchParams ? values[(size_t)index] : fallback;
+    return static_cast<float>(state.getProperty(JunoParams::getID(index), fallback));
+}
+
+juce::ValueTree PresetManager::Preset::getState() const {
+    if (!isPatch) return state;
     
-    // Add factory sounds from header
-    for (const auto& data : junoFactoryPresets) {
-        bank.patches.push_back(createPresetFromJunoBytes(data.name, data.bytes));
+    juce::ValueTree tree("Parameters");
+    for (int i = 0; i < JunoParams::NumPatchParams; ++i) {
+        const auto& spec = JunoParams::kSpecs[(size_t)i];
+        const auto value = values[(size_t)i];
+        switch (spec.type) {
+            case JunoParams::Type::Float: tree.setProperty(spec.id, value, nullptr); break;
+            case JunoParams::Type::Int:   tree.setProperty(spec.id, static_cast<int>(value), nullptr); break;
+            case JunoParams::Type::Bool:  tree.setProperty(spec.id, value > 0.5f, nullptr); break;
+        }
     }
+    return tree;
+}
+
+void PresetManager::loadFactoryPresets() {
+    // Decoded once per process
+    banks[0].patches = shared->getFactoryBank().patches;
 }
 
 void PresetManager::loadUserPresets() {
-    // For now, user presets are just another bank
+    // For now, user presets are just another bank (scanned once per process)
     addBank("User Bank");
-    Bank& bank = banks.back();
-    
-    auto userDir = getUserPresetsDirectory();
-    if (!userDir.exists()) return;
-    auto files = userDir.findChildFiles(juce::File::findFiles, false, "*.json");
-    for (const auto& file : files) {
-        auto json = juce::JSON::parse(file);
-        if (json.isObject()) {
-            auto obj = json.getDynamicObject();
-            if (obj != nullptr) {
-                juce::String name = obj->getProperty("name").toString();
-                auto stateVar = obj->getProperty("state");
-                if (stateVar.isObject()) {
-                    juce::ValueTree state = juce::ValueTree::fromXml(stateVar.toString());
-                    if (state.isValid()) bank.patches.push_back(Preset(name, "User", state));
-                }
-            }
-        }
-    }
+    banks.back().patches = shared->getUserBank().patches;
 }
 
 void PresetManager::saveUserPreset(const juce::String& name, const juce::ValueTree& state) {
@@ -161,12 +120,16 @@ void PresetManager::saveUserPreset(const juce::String& name, const juce::ValueTr
     obj->setProperty("state", state.toXmlString());
     juce::var json(obj.get());
     file.replaceWithText(juce::JSON::toString(json));
+    
+    // Instances opened from now on see it without rescanning
+    shared->setUserPreset(Preset(name, "User", state.createCopy()));
 }
 
 void PresetManager::deleteUserPreset(const juce::String& name) {
     auto userDir = getUserPresetsDirectory();
     auto file = userDir.getChildFile(name + ".json");
     file.deleteFile();
+    shared->removeUserPreset(name);
 }
 
 juce::StringArray PresetManager::getPresetNames() const {
@@ -189,6 +152,5 @@ void PresetManager::setCurrentPreset(int index) {
 }
 
 juce::File PresetManager::getUserPresetsDirectory() const {
-    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
-        .getChildFile("SimpleJuno106v2").getChildFile("UserPresets");
+    return JunoSharedResources::getUserPresetsDirectory();
 }
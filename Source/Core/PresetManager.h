@@ -1,6 +1,9 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "JunoSysEx.h"
+
+class JunoSharedResources;
 
 /**
  * PresetManager - Manages factory and user presets
@@ -10,17 +13,29 @@
  * - User presets (saved to AppData as JSON)
  * - Load/Save functionality
  * - Preset list management
+ * - Factory bank and user library come from JunoSharedResources (decoded /
+ *   scanned once per process, shared by every instance)
+ * - Juno patches (factory, tape) keep their decoded values; the ValueTree
+ *   form is only built when asked for (getState)
  */
 class PresetManager {
 public:
     struct Preset {
         juce::String name;
         juce::String category; // "Factory", "User", or Tape name
-        juce::ValueTree state;
+        juce::ValueTree state;             // User presets
+        JunoSysEx::PatchValues values {};  // Juno patches (isPatch)
+        bool isPatch = false;
         
         Preset() = default;
         Preset(const juce::String& n, const juce::String& cat, const juce::ValueTree& s)
             : name(n), category(cat), state(s) {}
+        Preset(const juce::String& n, const juce::String& cat, const JunoSysEx::PatchValues& v)
+            : name(n), category(cat), values(v), isPatch(true) {}
+        
+        // Parameter value by ID (fallback if the preset does not set it)
+        float getValue(JunoParams::Index index, float fallback) const;
+        juce::ValueTree getState() const;
     };
 
     struct Bank {
@@ -31,7 +46,7 @@ public:
     };
     
     PresetManager();
-    ~PresetManager() = default;
+    ~PresetManager();
     
     // Bank management
     void addBank(const juce::String& name);
@@ -60,7 +75,11 @@ public:
     // File paths
     juce::File getUserPresetsDirectory() const;
     
+    // Juno-106 patch bytes (18: 16 sliders + SW1 + SW2) to a preset
+    static Preset createPresetFromJunoBytes(const juce::String& name, const unsigned char* bytes);
+    
 private:
+    juce::SharedResourcePointer<JunoSharedResources> shared;
     std::vector<Bank> banks;
     int currentBankIndex = 0;
     int currentPresetIndex = 0;
@@ -71,8 +90,6 @@ private:
                             float attack, float decay, float sustain, float release,
                             float lfoRate, float lfoDepth, int lfoDest,
                             bool chorusI, bool chorusII, bool gateMode);
-
-    Preset createPresetFromJunoBytes(const juce::String& name, const unsigned char* bytes);
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PresetManager)
 };
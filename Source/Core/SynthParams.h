@@ -48,12 +48,13 @@ struct SynthParams {
     
     // POLY Modes (Authentic Juno-106)
     int polyMode = 0;           // 0=POLY1, 1=POLY2, 2=UNISON
+    int numVoices = 6;          // 6 = Juno-106, up to 32 (stacked pads)
     
     // Master
     float vcaLevel = 0.8f;      // 0-1
     
     // Bender
-    float benderValue = 0.0f;   // -1 to +1
+    float benderValue = 0.0f;   // -1 to +1 (end of block; voices read JunoModulationBus)
     float benderToDCO = 1.0f;   // 0-1 (amount to pitch)
     float benderToVCF = 0.0f;   // 0-1 (amount to filter)
     float benderToLFO = 0.0f;   // 0-1 (amount to LFO rate)
@@ -62,10 +63,14 @@ struct SynthParams {
     float drift = 0.0f;            // 0 to 1, analog drift amount
     float tune = 0.0f;             // ±50 cents (Master Tune)
     
+    // Engine
+    int controlRateMs = 0;         // 0=Audio rate, 1-4 ms (CPU update tick for ADSR/LFO)
+    float tailFloorDb = -96.0f;    // Release tails below this peak (dBFS) are retired; -120 = off
+    
     // VCF Modulation (Juno-106 authentic controls)
     // vcfEnvAmount removed (consolidated with envAmount)
 
-    float vcfLFOAmount = 0.0f;     // LFO: 0 to 1 (LFO modulation depth)
+    float vcfLFOAmount = 0.0f;     // LFO: 0 to 1 (LFO modulation depth, before mod lever)
     float lfoToVCF = 0.0f;         // LFO: 0 to 1 (authentic LFO to VCF slider)
     float kybdTracking = 0.0f;     // KYBD: 0 to 1 (keyboard tracking amount)
     int vcfPolarity = 0;           // 0=Normal, 1=Inverted
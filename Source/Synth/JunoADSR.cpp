@@ -1,6 +1,7 @@
 // Source/Synth/JunoADSR.cpp
 #include "JunoADSR.h"
 #include <algorithm>
+#include <cmath>
 
 JunoADSR::JunoADSR() {
     reset();
@@ -137,3 +138,96 @@ float JunoADSR::getNextSample() {
     
     return currentValue;
 }
+
+void JunoADSR::processBlock(float* output, int numSamples) {
+    int i = 0;
+    
+    while (i < numSamples) {
+        const int remaining = numSamples - i;
+        
+        // Constant stages: fill the rest of the block
+        if (gateMode) {
+            if (stage == Stage::Release || stage == Stage::Idle) {
+                currentValue = 0.0f;
+                stage = Stage::Idle;
+            } else {
+                currentValue = 1.0f;
+            }
+            juce::FloatVectorOperations::fill(output + i, currentValue, remaining);
+            return;
+        }
+        
+        if (stage == Stage::Idle || stage == Stage::Sustain) {
+            currentValue = (stage == Stage::Sustain) ? sustainLevel : 0.0f;
+            juce::FloatVectorOperations::fill(output + i, currentValue, remaining);
+            return;
+        }
+        
+        // Exponential stages: distance to the target shrinks by (1 - rate) per
+        // sample, so the samples before the end condition can be counted.
+        float target = 0.0f;
+        float rate = 0.0f;
+        int run = 0;
+        
+        switch (stage) {
+            case Stage::Attack:
+                target = 1.01f;
+                rate = attackRate;
+                run = getSafeRunLength(target - currentValue, target - 1.0f, rate, remaining);
+                break;
+            case Stage::Decay:
+                target = sustainLevel;
+                rate = decayRate;
+                run = getSafeRunLength(std::abs(currentValue - target), 0.001f, rate, remaining);
+                break;
+            case Stage::Release:
+                target = 0.0f;
+                rate = releaseRate;
+                run = getSafeRunLength(currentValue, 0.001f, rate, remaining);
+                break;
+            default:
+                break;
+        }
+        
+        if (run > 0) {
+            fillSegment(output + i, run, target, rate);
+            i += run;
+        } else {
+            // Near a transition: step exactly
+            output[i++] = getNextSample();
+        }
+    }
+}
+
+int JunoADSR::getSafeRunLength(float distance, float endDistance, float rate, int maxSamples) const {
+    if (rate >= 1.0f || distance <= endDistance) return 0;
+    if (rate <= 0.0f) return maxSamples;
+    
+    // distance * (1 - rate)^k reaches endDistance after k samples. One sample of
+    // margin keeps float rounding from skipping the transition.
+    double k = std::log(static_cast<double>(endDistance) / distance) / std::log1p(-static_cast<double>(rate));
+    if (!(k < static_cast<double>(maxSamples))) return maxSamples;
+    return std::max(0, static_cast<int>(k) - 1);
+}
+
+void JunoADSR::fillSegment(float* output, int numSamples, float target, float rate) {
+    // output[k] = target + (value - target) * g^(k+1), evaluated in 4 independent
+    // lanes so the loop has no serial dependency and can be vectorised
+    const float g = 1.0f - rate;
+    const float g4 = (g * g) * (g * g);
+    const float d = currentValue - target;
+    float lane[4] = { d * g, d * g * g, d * g * g * g, d * g4 };
+    
+    int k = 0;
+    for (; k + 4 <= numSamples; k += 4) {
+        for (int j = 0; j < 4; ++j) {
+            output[k + j] = target + lane[j];
+            lane[j] *= g4;
+        }
+    }
+    for (int j = 0; k + j < numSamples; ++j) {
+        output[k + j] = target + lane[j];
+    }
+    
+    currentValue = output[numSamples - 1];
+}
@@ -16,6 +16,9 @@
  * - Uses only JUCE standard components
  * - Per-sample processing for stability
  * - Simple linear math (no pow/exp)
+ * - Block processing: each stage is a closed-form one-pole segment, so the
+ *   samples before a transition are filled without per-sample branching and
+ *   only the transition itself is stepped sample by sample
  */
 class JunoADSR {
 public:
@@ -46,6 +49,7 @@ public:
     
     // Processing
     float getNextSample();
+    void processBlock(float* output, int numSamples);
     bool isActive() const { return stage != Stage::Idle; }
     
     Stage getCurrentStage() const { return stage; }
@@ -70,6 +74,8 @@ private:
     Stage stage = Stage::Idle;
     float currentValue = 0.0f;
     
-    // Helper
+    // Helpers
     void calculateRates();
+    int getSafeRunLength(float distance, float endDistance, float rate, int maxSamples) const;
+    void fillSegment(float* output, int numSamples, float target, float rate);
 };
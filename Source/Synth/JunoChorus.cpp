@@ -0,0 +1,165 @@
+// Source/Synth/JunoChorus.cpp
+#include "JunoChorus.h"
+#include <cmath>
+
+void JunoChorus::prepare(double sr, int maxBlockSize) {
+    sampleRate = sr;
+
+    // Longest delay plus the interpolation neighbour, rounded up to a power of two
+    const int maxDelay = static_cast<int>(std::ceil(5.35 * 0.001 * sr)) + 2;
+    int size = 1;
+    while (size < maxDelay) size <<= 1;
+    line.assign(static_cast<size_t>(size), 0.0f);
+    lineMask = size - 1;
+
+    wetBuffer.setSize(2, juce::jmax(1, maxBlockSize));
+    wetCoeff = 1.0f - std::exp(-juce::MathConstants<float>::twoPi * kWetCutoffHz / static_cast<float>(sr));
+
+    configureTap(current, current.mode);
+    configureTap(previous, previous.mode);
+    reset();
+}
+
+void JunoChorus::reset() {
+    std::fill(line.begin(), line.end(), 0.0f);
+    writePos = 0;
+    wetState.fill(0.0f);
+    current.phase = previous.phase = 0.0f;
+    fade = 1.0f;
+    fadeStep = 0.0f;
+    pendingMode = current.mode;
+}
+
+void JunoChorus::configureTap(Tap& tap, int mode) const {
+    const auto& settings = kModes[(size_t)juce::jlimit(0, 3, mode)];
+    const float msToSamples = static_cast<float>(sampleRate) * 0.001f;
+
+    tap.mode = juce::jlimit(0, 3, mode);
+    tap.phaseInc = settings.rateHz / static_cast<float>(sampleRate);
+    tap.centre = 0.5f * (settings.minDelayMs + settings.maxDelayMs) * msToSamples;
+    tap.depth = 0.5f * (settings.maxDelayMs - settings.minDelayMs) * msToSamples;
+}
+
+void JunoChorus::setMode(int mode) {
+    pendingMode = juce::jlimit(0, 3, mode);
+
+    // A running crossfade finishes first (process() picks the mode up)
+    if (fadeStep > 0.0f || pendingMode == current.mode) return;
+    startCrossfade(pendingMode);
+}
+
+void JunoChorus::startCrossfade(int mode) {
+    // Coming out of bypass: the line was not written meanwhile
+    if (current.mode == Off && fadeStep == 0.0f) {
+        std::fill(line.begin(), line.end(), 0.0f);
+        wetState.fill(0.0f);
+    }
+
+    // Old settings keep sweeping from where they are while they fade out
+    previous = current;
+    configureTap(current, mode);
+    current.phase = previous.phase;
+
+    fade = 0.0f;
+    fadeStep = 1.0f / juce::jmax(1.0f, kCrossfadeSeconds * static_cast<float>(sampleRate));
+}
+
+float JunoChorus::readDelay(float delaySamples) const {
+    // Offset by the line length so the read position stays positive
+    const float readPos = static_cast<float>(writePos + lineMask + 1) - delaySamples;
+    const int i0 = static_cast<int>(readPos);
+    const float frac = readPos - static_cast<float>(i0);
+    const float a = line[(size_t)(i0 & lineMask)];
+    const float b = line[(size_t)((i0 + 1) & lineMask)];
+    return a + frac * (b - a);
+}
+
+void JunoChorus::process(juce::AudioBuffer<float>& buffer, int numSamples) {
+    if (line.empty() || numSamples <= 0) return;
+
+    // Bypassed: the dry signal passes untouched
+    if (current.mode == Off && fadeStep == 0.0f) return;
+
+    float* left = buffer.getWritePointer(0);
+    float* right = buffer.getNumChannels() > 1 ? buffer.getWritePointer(1) : nullptr;
+    const bool stereo = right != nullptr && !economy;
+
+    // Host exceeded the prepared block size: process in prepared-size pieces
+    const int capacity = wetBuffer.getNumSamples();
+    float* wetL = wetBuffer.getWritePointer(0);
+    float* wetR = wetBuffer.getWritePointer(1);
+
+    for (int start = 0; start < numSamples; start += capacity) {
+        const int n = juce::jmin(capacity, numSamples - start);
+        float* l = left + start;
+        float* r = right != nullptr ? right + start : nullptr;
+
+        // Crossfading blocks mix per sample (dry gain moves too); steady
+        // blocks collect the wet signal and mix with vector ops
+        const bool fadingBlock = fadeStep > 0.0f;
+
+        auto readTap = [this, stereo](Tap& tap, float& outL, float& outR) {
+            if (tap.mode == Off) {
+                outL = outR = 0.0f;
+                return;
+            }
+            const float sweep = tap.depth * triangle(tap.phase);
+            outL = readDelay(tap.centre + sweep);
+            outR = stereo ? readDelay(tap.centre - sweep) : outL;
+            tap.phase += tap.phaseInc;
+            if (tap.phase >= 1.0f) tap.phase -= 1.0f;
+        };
+        auto dryGain = [](int mode) { return mode == Off ? 1.0f : kMixGain; };
+
+        for (int i = 0; i < n; ++i) {
+            const float x = l[i];
+            line[(size_t)writePos] = x;
+
+            float yl, yr;
+            readTap(current, yl, yr);
+            float dry = kMixGain;
+
+            if (fadeStep > 0.0f) {
+                float pl, pr;
+                readTap(previous, pl, pr);
+                yl = pl + (yl - pl) * fade;
+                yr = pr + (yr - pr) * fade;
+                dry = dryGain(previous.mode) + (dryGain(current.mode) - dryGain(previous.mode)) * fade;
+
+                fade += fadeStep;
+                if (fade >= 1.0f) {
+                    fade = 1.0f;
+                    fadeStep = 0.0f;
+                    if (pendingMode != current.mode) startCrossfade(pendingMode);
+                }
+            } else if (current.mode == Off) {
+                dry = 1.0f;
+            }
+
+            // BBD output filtering
+            wetState[0] += (yl - wetState[0]) * wetCoeff;
+            wetState[1] += (yr - wetState[1]) * wetCoeff;
+
+            if (fadingBlock) {
+                const float wetGain = current.mode == Off && fadeStep == 0.0f ? 0.0f : kMixGain;
+                l[i] = x * dry + wetState[0] * wetGain;
+                if (r != nullptr) r[i] = x * dry + (stereo ? wetState[1] : wetState[0]) * wetGain;
+            } else {
+                wetL[i] = wetState[0];
+                wetR[i] = wetState[1];
+            }
+
+            writePos = (writePos + 1) & lineMask;
+        }
+
+        if (!fadingBlock) {
+            // out = (dry + wet) / 2 per side
+            if (r != nullptr) {
+                juce::FloatVectorOperations::copyWithMultiply(r, l, kMixGain, n);
+                juce::FloatVectorOperations::addWithMultiply(r, stereo ? wetR : wetL, kMixGain, n);
+            }
+            juce::FloatVectorOperations::multiply(l, kMixGain, n);
+            juce::FloatVectorOperations::addWithMultiply(l, wetL, kMixGain, n);
+        }
+    }
+}
@@ -0,0 +1,101 @@
+// Source/Synth/JunoChorus.h
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+
+/**
+ * JunoChorus - Juno-106 BBD chorus (two MN3009 lines)
+ *
+ * CHARACTERISTICS:
+ * - Mono in, stereo out: one bucket-brigade line per side, both swept by
+ *   the same triangle LFO in opposite phase (left +LFO, right -LFO)
+ * - Modes (service notes / measurements):
+ *     I     0.513 Hz, 1.66 - 5.35 ms
+ *     II    0.863 Hz, 1.66 - 5.35 ms
+ *     I+II  9.75 Hz,  3.30 - 3.70 ms (fast, shallow vibrato-like sweep)
+ * - Dry and wet summed at equal level; wet darkened by a one-pole lowpass
+ *   (BBD clock / anti-aliasing filters)
+ *
+ * IMPLEMENTATION:
+ * - Fixed power-of-two ring buffer sized in prepare() (no allocation later)
+ * - Linear fractional-delay interpolation (the wet lowpass hides its HF loss)
+ * - Both sides come from one write and one LFO step per sample; the dry/wet
+ *   mix runs over whole blocks with FloatVectorOperations
+ * - setMode() only acts on a change: the old and new settings are read from
+ *   the same ring buffer and crossfaded over 20 ms (Off included). A change
+ *   during a crossfade is queued and starts when the running one finishes,
+ *   so the tap that is still audible is never dropped
+ * - Economy: right side is a copy of the left (CPU governor)
+ */
+class JunoChorus {
+public:
+    enum Mode {
+        Off = 0,
+        ChorusI,
+        ChorusII,
+        ChorusBoth
+    };
+
+    JunoChorus() = default;
+
+    void prepare(double sampleRate, int maxBlockSize);
+    void reset();
+
+    void setMode(int mode);             // Off / I / II / I+II
+    void setEconomy(bool enabled) { economy = enabled; }
+
+    // Channel 0 is the (mono) input; writes channels 0 and 1 (if present)
+    void process(juce::AudioBuffer<float>& buffer, int numSamples);
+
+private:
+    struct ModeSettings {
+        float rateHz;
+        float minDelayMs;
+        float maxDelayMs;
+    };
+    static constexpr std::array<ModeSettings, 4> kModes {{
+        { 0.0f,   0.0f,  0.0f  },   // Off
+        { 0.513f, 1.66f, 5.35f },   // I
+        { 0.863f, 1.66f, 5.35f },   // II
+        { 9.75f,  3.30f, 3.70f }    // I+II
+    }};
+
+    static constexpr float kCrossfadeSeconds = 0.02f;
+    static constexpr float kWetCutoffHz = 7500.0f;
+    static constexpr float kMixGain = 0.5f;  // Dry and wet at equal level
+
+    // One set of LFO + delay settings reading the shared line
+    struct Tap {
+        int mode = Off;
+        float phase = 0.0f;       // 0-1, triangle
+        float phaseInc = 0.0f;
+        float centre = 0.0f;      // Samples
+        float depth = 0.0f;       // Samples
+    };
+
+    void configureTap(Tap& tap, int mode) const;
+    void startCrossfade(int mode);
+    float readDelay(float delaySamples) const;
+    static float triangle(float phase) { return 4.0f * std::abs(phase - 0.5f) - 1.0f; }
+
+    double sampleRate = 44100.0;
+
+    // Ring buffer (power of two, mask indexing)
+    std::vector<float> line;
+    int lineMask = 0;
+    int writePos = 0;
+
+    Tap current, previous;
+    float fade = 1.0f;            // 0 -> 1 from previous to current
+    float fadeStep = 0.0f;
+    int pendingMode = Off;        // Latest requested mode (applied once no fade runs)
+
+    float wetCoeff = 1.0f;
+    std::array<float, 2> wetState {};
+    bool economy = false;
+
+    // Wet signal per side for the block mix
+    juce::AudioBuffer<float> wetBuffer;
+};
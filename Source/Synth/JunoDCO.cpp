@@ -1,38 +1,32 @@
 // Source/Synth/JunoDCO.cpp
 #include "JunoDCO.h"
+#include "JunoFastMath.h"
 #include <cmath>
 
 JunoDCO::JunoDCO() {
-    // Sawtooth using JUCE Oscillator
-    sawOsc.initialise([](float x) {
-        return juce::jmap(x, 
-                         -juce::MathConstants<float>::pi, 
-                          juce::MathConstants<float>::pi, 
-                         -1.0f, 1.0f);
-    }, 128);
-    
     updateRangeMultiplier();
     reset();
 }
 
 void JunoDCO::prepare(double sr, int maxBlockSize) {
+    juce::ignoreUnused(maxBlockSize);
     sampleRate = sr;
-    
-    juce::dsp::ProcessSpec spec;
-    spec.sampleRate = sr;
-    spec.maximumBlockSize = static_cast<juce::uint32>(maxBlockSize);
-    spec.numChannels = 1;
-    
-    sawOsc.prepare(spec);
+    updatePWMSlew();
     reset();
 }
 
+void JunoDCO::setSampleRate(double sr) {
+    sampleRate = sr;
+    updatePWMSlew();
+}
+
+void JunoDCO::updatePWMSlew() {
+    // Same slew time at every oversampling factor
+    pwmSlewCoeff = 1.0f - JunoFastMath::exp(-1.0f / (kPWMSlewSeconds * static_cast<float>(sampleRate)));
+}
+
 void JunoDCO::reset() {
-    sawOsc.reset();
-    pulsePhase = 0.0;
-    driftMigrator = 0.0f;
-    driftTarget = 0.0f;
-    driftCounter = 0;
+    phase = 0.0;
     currentPWM = pwmValue;
     subFlipFlop = false;
 }
@@ -78,56 +72,33 @@ void JunoDCO::setPWMMode(PWMMode mode) {
     pwmMode = mode;
 }
 
-void JunoDCO::setLFODepth(float depth) {
-    lfoDepth = juce::jlimit(0.0f, 1.0f, depth);
-}
-
-void JunoDCO::setDrift(float amount) {
-    driftAmount = juce::jlimit(0.0f, 1.0f, amount);
-}
-
-float JunoDCO::getNextSample(float lfoValue) {
-    // === ANALOG DRIFT (Random Walk) ===
-    // Update target occasionally to create "wandering" pitch
-    if (++driftCounter > 1000) {
-        driftCounter = 0;
-        // Random walk target between -1.0 and 1.0
-        driftTarget = (noiseGen.nextFloat() * 2.0f - 1.0f); 
-    }
-    
-    // Smoothly migrate towards target (Simulate thermal capacitance/instability)
-    driftMigrator += (driftTarget - driftMigrator) * 0.005f;
-    
-    // Scale by user drift amount (Max 15 cents equivalent)
-    float driftSemitones = driftMigrator * driftAmount * 0.15f; 
-    
-    // === FREQUENCY with RANGE, LFO, and DRIFT ===
-    float freq = baseFrequency * rangeMultiplier;
-    
-    // Apply LFO to pitch (vibrato)
-    float lfoSemitones = lfoValue * lfoDepth * 0.5f; // LFO max range ~ half semitone (checked/reduced)
-    freq *= std::pow(2.0f, (lfoSemitones + driftSemitones) / 12.0f);
+float JunoDCO::getNextSample(float lfoValue, float pitchRatio, float noiseSample) {
+    // === FREQUENCY with RANGE, DRIFT and PITCH MOD (LFO + Bender) ===
+    float freq = baseFrequency * rangeMultiplier * driftRatio * pitchRatio;
     
     // Nyquist check
     if (freq >= sampleRate * 0.49f) {
         freq = static_cast<float>(sampleRate * 0.49);
     }
     
-    sawOsc.setFrequency(freq);
-    
-    // === UPDATE PHASE (Must happen even if Pulse is OFF for Sub Osc) ===
+    // === UPDATE PHASE (single ramp for all waveforms) ===
     double dt = freq / sampleRate;
-    pulsePhase += dt;
-    if (pulsePhase >= 1.0) {
-        pulsePhase -= 1.0;
+    phase += dt;
+    if (phase >= 1.0) {
+        phase -= 1.0;
         subFlipFlop = !subFlipFlop; // Authentic: Sub is derived from DCO clock
     }
     
     float output = 0.0f;
+    const float p = static_cast<float>(phase);
+    const int level = wavetables.getLevel(static_cast<float>(dt));
     
-    // === 1. SAWTOOTH (JUCE) ===
+    // === 1. SAWTOOTH (the ramp, band-limited) ===
+    float saw = 0.0f;
+    if (sawLevel > 0.0f || pulseLevel > 0.0f) {
+        saw = wavetables.saw(level, p);
+    }
     if (sawLevel > 0.0f) {
-        float saw = sawOsc.processSample(0.0f);
         output += saw * sawLevel;
     }
     
@@ -145,23 +116,27 @@ float JunoDCO::getNextSample(float lfoValue) {
         }
         
         // Slew PWM
-        currentPWM += (targetPWM - currentPWM) * 0.01f;
+        currentPWM += (targetPWM - currentPWM) * pwmSlewCoeff;
         
-        // Generate pulse
-        float pulse = (pulsePhase < currentPWM) ? 1.0f : -1.0f;
+        // Generate pulse: comparator on the ramp = difference of two saws
+        float shifted = p - currentPWM;
+        if (shifted < 0.0f) shifted += 1.0f;
+        float pulse = wavetables.saw(level, shifted) - saw + 2.0f * currentPWM - 1.0f;
         output += pulse * pulseLevel;
     }
     
     // === 3. SUB-OSCILLATOR ===
     if (subLevel > 0.0f) {
-        float sub = subFlipFlop ? 1.0f : -1.0f;
+        // Square at half rate: the flip-flop selects which half of the slow ramp we are in
+        const float q = 0.5f * (p + (subFlipFlop ? 1.0f : 0.0f));
+        const int subLevelIndex = wavetables.getLevel(static_cast<float>(dt) * 0.5f);
+        float sub = wavetables.saw(subLevelIndex, q) - wavetables.saw(subLevelIndex, q < 0.5f ? q + 0.5f : q - 0.5f);
         output += sub * subLevel;
     }
     
     // === 4. NOISE ===
     if (noiseLevel > 0.0f) {
-        float noise = noiseGen.nextFloat() * 2.0f - 1.0f;
-        output += noise * noiseLevel;
+        output += noiseSample * noiseLevel;
     }
     
     return output * 0.5f; 
@@ -2,24 +2,30 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "JunoWavetables.h"
 
 /**
  * JunoDCO - Complete Authentic Juno-106 DCO
  * 
  * AUTHENTIC CONTROLS (from front panel):
  * - RANGE: 16', 8', 4' (octave selector)
- * - LFO: LFO modulation depth to pitch
+ * - LFO: LFO modulation depth to pitch (applied by Voice, with the
+ *   modulation lever, as a per-sample pitch ratio)
  * - PWM: Pulse width (MAN) or PWM depth (LFO)
  * - LFO/MAN: PWM mode selector
  * - Waveforms: Pulse, Saw (both can be active)
  * - SUB: Sub-oscillator level
  * - NOISE: Noise generator level
  * 
- * JUCE COMPONENTS USED:
- * - juce::dsp::Oscillator for Sawtooth
- * - juce::Random for Noise
- * - Custom for Pulse (PWM slew support)
- * - Custom for Sub-osc (flip-flop authentic)
+ * IMPLEMENTATION:
+ * - One phase accumulator (the DCO counter ramp) drives all waveshapers,
+ *   so saw, pulse and sub are phase-locked as on the hardware:
+ *   - Saw: the ramp itself
+ *   - Pulse: comparator on the ramp (PWM slew support)
+ *   - Sub: divide-by-two flip-flop clocked by the ramp reset
+ * - Band-limited: all three are read from the shared JunoWavetables
+ *   mipmap (level per octave from the phase increment)
+ * - Noise supplied per sample by the Voice (shared JunoNoise source)
  */
 class JunoDCO {
 public:
@@ -37,6 +43,7 @@ public:
     JunoDCO();
     
     void prepare(double sampleRate, int maxBlockSize);
+    void setSampleRate(double sr);      // Keeps the phase (oversampling switch)
     void reset();
     
     // Frequency
@@ -55,22 +62,19 @@ public:
     void setPWM(float value);           // 0-1 (slider value)
     void setPWMMode(PWMMode mode);      // LFO or MAN
     
-    // LFO to DCO
-    void setLFODepth(float depth);      // 0-1 (LFO slider)
+    // Character: analog drift as a frequency multiplier (from JunoDrift, per block)
+    void setDriftRatio(float ratio) { driftRatio = ratio; }
     
-    // Character
-    void setDrift(float amount);        // 0-1 (analog drift)
-    
-    // Processing (receives LFO value from external LFO)
-    float getNextSample(float lfoValue);
+    // Processing (receives LFO value for PWM, the voice's pitch modulation:
+    // glide, tune, vibrato, bender, as a frequency ratio, and the noise source sample)
+    float getNextSample(float lfoValue, float pitchRatio = 1.0f, float noiseSample = 0.0f);
     
 private:
-    // JUCE Components
-    juce::dsp::Oscillator<float> sawOsc;
-    juce::Random noiseGen;
+    // Phase accumulator (0-1), shared by all waveforms
+    double phase = 0.0;
     
-    // Manual oscillators
-    double pulsePhase = 0.0;
+    // Shared band-limited tables (process-wide, immutable)
+    const JunoWavetables& wavetables = JunoWavetables::get();
     
     // Spec
     double sampleRate = 44100.0;
@@ -89,14 +93,13 @@ private:
     // PWM
     float pwmValue = 0.5f;
     PWMMode pwmMode = PWMMode::Manual;
-    float lfoDepth = 0.0f;
     float currentPWM = 0.5f;      // Slewed
+    float pwmSlewCoeff = 0.01f;   // One-pole, per sample at the current rate
+    static constexpr float kPWMSlewSeconds = 0.00226f;   // ~0.01 per sample at 44.1 kHz
+    void updatePWMSlew();
     
-    // Drift (Random Walk)
-    float driftAmount = 0.0f;
-    float driftMigrator = 0.0f;   // Current erratic tuning offset
-    float driftTarget = 0.0f;     // Target for random walk
-    int driftCounter = 0;         // Decimator for drift updates
+    // Drift (frequency ratio, 1.0 = in tune)
+    float driftRatio = 1.0f;
     
     // Sub-osc flip-flop (authentic)
     bool subFlipFlop = false;
@@ -0,0 +1,60 @@
+// Source/Synth/JunoDrift.cpp
+#include "JunoDrift.h"
+#include "JunoFastMath.h"
+#include <cmath>
+
+JunoDrift::JunoDrift(uint32_t seed) : random(seed) {
+    prepare(sampleRate, 1);
+}
+
+void JunoDrift::prepare(double sr, int numVoices) {
+    sampleRate = sr;
+    voiceWalks.assign((size_t)juce::jmax(1, numVoices), Walk{});
+    ratios.assign(voiceWalks.size(), 1.0f);
+    reset();
+}
+
+void JunoDrift::reset() {
+    random.reset();
+    thermal = Walk{};
+    for (auto& walk : voiceWalks) walk = Walk{};
+    std::fill(ratios.begin(), ratios.end(), 1.0f);
+}
+
+void JunoDrift::setSeed(uint32_t seed) {
+    random.setSeed(seed);
+    reset();
+}
+
+void JunoDrift::setAmount(float a) {
+    amount = juce::jlimit(0.0f, 1.0f, a);
+}
+
+void JunoDrift::step(Walk& walk, float dt, float interval, float coeff) {
+    // New random target at irregular intervals (0.5x to 1x the interval)
+    walk.timer -= dt;
+    if (walk.timer <= 0.0f) {
+        walk.target = random.getNextSample();
+        walk.timer += interval * (0.75f + 0.25f * random.getNextSample());
+    }
+    
+    // Thermal capacitance: one-pole approach to the target
+    walk.value += (walk.target - walk.value) * coeff;
+}
+
+void JunoDrift::advance(int numSamples) {
+    const float dt = static_cast<float>(numSamples / sampleRate);
+    const float thermalCoeff = 1.0f - std::exp(-dt / kThermalTau);
+    const float voiceCoeff = 1.0f - std::exp(-dt / kVoiceTau);
+    
+    // The walks keep moving with DRIFT at 0, so turning it up does not jump
+    step(thermal, dt, kThermalInterval, thermalCoeff);
+    
+    const float scale = amount * kMaxDriftSemitones / 12.0f; // Octaves
+    for (size_t i = 0; i < voiceWalks.size(); ++i) {
+        step(voiceWalks[i], dt, kVoiceInterval, voiceCoeff);
+        
+        float octaves = scale * (kThermalMix * thermal.value + (1.0f - kThermalMix) * voiceWalks[i].value);
+        ratios[i] = JunoFastMath::octavesToRatio(octaves);
+    }
+}
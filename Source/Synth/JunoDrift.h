@@ -0,0 +1,63 @@
+// Source/Synth/JunoDrift.h
+#pragma once
+
+#include <JuceHeader.h>
+#include "JunoNoise.h"
+#include <vector>
+
+/**
+ * JunoDrift - Analog pitch drift for all DCOs
+ * 
+ * CHARACTERISTICS:
+ * - Shared thermal state: slow wander common to every voice (the six DCOs
+ *   sit on one board and warm up together), so unison and chords drift
+ *   as a group instead of as six independent random walks
+ * - Per-voice component: faster, smaller, uncorrelated wander
+ * - DRIFT amount 0-1 (max 15 cents)
+ * 
+ * IMPLEMENTATION:
+ * - Updated once per block with time-based coefficients (block-size independent)
+ * - Each voice gets a precomputed frequency ratio; no per-sample work in the DCO
+ * - Seeded JunoNoise source (deterministic renders)
+ */
+class JunoDrift {
+public:
+    explicit JunoDrift(uint32_t seed = 1984);
+    
+    void prepare(double sampleRate, int numVoices);
+    void setSampleRate(double sr) { sampleRate = sr; }   // Keeps the walks
+    void reset();
+    void setSeed(uint32_t seed);
+    
+    void setAmount(float amount);        // 0-1 (DRIFT)
+    
+    // Advances the model by one block
+    void advance(int numSamples);
+    
+    // Frequency multiplier for a voice (1.0 = in tune), valid until the next advance
+    float getFrequencyRatio(int voiceIndex) const { return ratios[(size_t)voiceIndex]; }
+    
+private:
+    struct Walk {
+        float value = 0.0f;
+        float target = 0.0f;
+        float timer = 0.0f;              // Seconds until the next target
+    };
+    
+    static constexpr float kMaxDriftSemitones = 0.15f;
+    static constexpr float kThermalMix = 0.6f;        // Shared share of the total drift
+    static constexpr float kThermalInterval = 2.0f;   // Seconds between targets
+    static constexpr float kThermalTau = 1.5f;        // Thermal time constant
+    static constexpr float kVoiceInterval = 0.1f;
+    static constexpr float kVoiceTau = 0.05f;
+    
+    double sampleRate = 44100.0;
+    float amount = 0.0f;
+    
+    JunoNoise random;
+    Walk thermal;
+    std::vector<Walk> voiceWalks;
+    std::vector<float> ratios;
+    
+    void step(Walk& walk, float dt, float interval, float coeff);
+};
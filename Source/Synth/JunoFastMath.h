@@ -0,0 +1,144 @@
+// Source/Synth/JunoFastMath.h
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * JunoFastMath - Pitch and cutoff conversions for the audio path
+ *
+ * Replaces std::pow(2, x / 12) and friends in every frequency path
+ * (DCO pitch modulation, drift, VCF cutoff, keyboard tracking, LFO rate)
+ * and in the per-voice time constants (VCF pole, ADSR times, glide).
+ *
+ * ACCURACY (float32 evaluation, measured over the full reduced range):
+ * - exp2: relative error < 2.0e-7 (~0.0003 cents), exact at integers
+ * - log2: absolute error < 4.0e-6 octaves (~0.005 cents)
+ * - midiNoteToHz: table, correctly rounded double -> float
+ *
+ * IMPLEMENTATION:
+ * - exp2: integer part written straight into the exponent bits, fraction
+ *   through a degree-5 minimax polynomial (p(0) = 1)
+ * - log2: exponent bits + degree-6 minimax polynomial on [sqrt(1/2), sqrt(2))
+ * - Block versions are branch-free loops over independent samples, so the
+ *   compiler vectorises them (SSE/AVX/NEON)
+ * - Input is clamped to the normal float range; no NaN/Inf handling
+ */
+namespace JunoFastMath
+{
+    //==============================================================================
+    // Bit helpers
+    inline float bitsToFloat(uint32_t bits) { float f; std::memcpy(&f, &bits, sizeof(f)); return f; }
+    inline uint32_t floatToBits(float f) { uint32_t bits; std::memcpy(&bits, &f, sizeof(bits)); return bits; }
+
+    //==============================================================================
+    // 2^x
+    inline float exp2(float x)
+    {
+        x = x < -126.0f ? -126.0f : (x > 126.0f ? 126.0f : x);
+
+        // floor() without a library call: truncate, then correct negatives
+        int32_t xi = static_cast<int32_t>(x);
+        xi -= (x < static_cast<float>(xi)) ? 1 : 0;
+        const float f = x - static_cast<float>(xi);
+
+        // 2^f on [0, 1)
+        float p = 0.00186713282f;
+        p = p * f + 0.0090170245f;
+        p = p * f + 0.0557999173f;
+        p = p * f + 0.240164449f;
+        p = p * f + 0.693151312f;
+        p = p * f + 1.0f;
+
+        return p * bitsToFloat(static_cast<uint32_t>(xi + 127) << 23);
+    }
+
+    // log2(x), x > 0
+    inline float log2(float x)
+    {
+        constexpr float kSqrt2 = 1.41421356f;
+
+        uint32_t bits = floatToBits(x);
+        int32_t e = static_cast<int32_t>((bits >> 23) & 0xFF) - 127;
+        float m = bitsToFloat((bits & 0x007FFFFFu) | 0x3F800000u); // [1, 2)
+
+        // Centre the mantissa on 1: [sqrt(1/2), sqrt(2))
+        const bool high = m >= kSqrt2;
+        m = high ? m * 0.5f : m;
+        e += high ? 1 : 0;
+
+        const float t = m - 1.0f;
+        float p = -0.206592186f;
+        p = p * t + 0.322155477f;
+        p = p * t - 0.36749007f;
+        p = p * t + 0.479347958f;
+        p = p * t - 0.721131852f;
+        p = p * t + 1.44271348f;
+
+        return static_cast<float>(e) + p * t;
+    }
+
+    //==============================================================================
+    // Musical conversions
+    inline float octavesToRatio(float octaves)     { return exp2(octaves); }
+    inline float semitonesToRatio(float semitones) { return exp2(semitones * (1.0f / 12.0f)); }
+    inline float ratioToSemitones(float ratio)     { return 12.0f * log2(ratio); }
+
+    // e^x (one-pole and glide coefficients)
+    inline float exp(float x) { return exp2(x * 1.44269504089f); }   // log2(e)
+
+    // minHz * (maxHz / minHz)^normalised, for log-scaled sliders
+    inline float logScale(float normalised, float minHz, float log2Range)
+    {
+        return minHz * exp2(normalised * log2Range);
+    }
+
+    //==============================================================================
+    // Block versions (in-place allowed)
+    inline void exp2(const float* input, float* output, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i) output[i] = exp2(input[i]);
+    }
+
+    inline void semitonesToRatio(const float* input, float* output, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i) output[i] = exp2(input[i] * (1.0f / 12.0f));
+    }
+
+    inline void log2(const float* input, float* output, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i) output[i] = log2(input[i]);
+    }
+
+    //==============================================================================
+    // MIDI note -> Hz (A4 = 440 Hz), built at compile time
+    namespace detail
+    {
+        constexpr std::array<float, 128> makeNoteTable()
+        {
+            // 2^(1/12), repeated multiplication in double (error << float precision)
+            constexpr double kSemitone = 1.0594630943592952646;
+            std::array<float, 128> table {};
+            double hz = 440.0;
+            for (int n = 69; n < 128; ++n) { table[(size_t)n] = static_cast<float>(hz); hz *= kSemitone; }
+            hz = 440.0;
+            for (int n = 69; n >= 0; --n) { table[(size_t)n] = static_cast<float>(hz); hz /= kSemitone; }
+            return table;
+        }
+    }
+
+    inline constexpr std::array<float, 128> kNoteHz = detail::makeNoteTable();
+
+    inline float midiNoteToHz(int note)
+    {
+        return kNoteHz[(size_t)(note < 0 ? 0 : (note > 127 ? 127 : note))];
+    }
+
+    //==============================================================================
+    // log2 of the fixed slider ranges used by the engine
+    inline constexpr float kLog2VCFRange = 11.2288186905f;   // log2(24000 / 10)
+    inline constexpr float kLog2LFORange = 8.22881869050f;   // log2(30 / 0.1)
+    inline constexpr float kLog2AttackRange = 10.9657842847f; // log2(3 / 0.0015)
+    inline constexpr float kLog2DecayRange = 12.9657842847f;  // log2(12 / 0.0015), decay and release
+}
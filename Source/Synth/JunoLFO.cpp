@@ -2,37 +2,53 @@
 #include "JunoLFO.h"
 #include <cmath>
 
+namespace {
+    // sin(2 pi phase - pi), phase in [0, 1) (same start as juce::dsp::Oscillator):
+    // folded to [-1/4, 1/4] turn, then Taylor to x^9
+    inline float sinTurns(float phase) {
+        float t = phase - 0.5f;
+        if (t > 0.25f) t = 0.5f - t;
+        else if (t < -0.25f) t = -0.5f - t;
+        
+        const float x = t * juce::MathConstants<float>::twoPi;
+        const float x2 = x * x;
+        return x * (1.0f + x2 * (-1.0f / 6.0f + x2 * (1.0f / 120.0f + x2 * (-1.0f / 5040.0f + x2 * (1.0f / 362880.0f)))));
+    }
+}
+
 JunoLFO::JunoLFO() {
-    // Initialize sine wave (authentic Juno-106)
-    oscillator.initialise([](float x) { 
-        return std::sin(x); 
-    }, 128);
+    updatePhaseIncrement();
 }
 
-void JunoLFO::prepare(double sr, int maxBlockSize) {
+void JunoLFO::prepare(double sr, int /*maxBlockSize*/) {
     sampleRate = sr;
-    
-    juce::dsp::ProcessSpec spec;
-    spec.sampleRate = sr;
-    spec.maximumBlockSize = static_cast<juce::uint32>(maxBlockSize);
-    spec.numChannels = 1;
-    
-    oscillator.prepare(spec);
-    oscillator.setFrequency(rate);
+    updatePhaseIncrement();
     reset();
 }
 
+void JunoLFO::setUpdateRate(double updateRate) {
+    if (updateRate == sampleRate) return;
+    sampleRate = updateRate;
+    
+    // The phase carries on; the delay envelope is kept
+    updatePhaseIncrement();
+}
+
 void JunoLFO::reset() {
-    oscillator.reset();
+    phase = 0.0f;
     delayTimer = 0.0f;
     delayEnvelope = 0.0f;
     currentValue = 0.0f;
     noteActive = false;
 }
 
+void JunoLFO::updatePhaseIncrement() {
+    phaseInc = static_cast<float>(rate / sampleRate);
+}
+
 void JunoLFO::setRate(float hz) {
     rate = juce::jlimit(0.1f, 30.0f, hz);
-    oscillator.setFrequency(rate);
+    updatePhaseIncrement();
 }
 
 void JunoLFO::setDepth(float amount) {
@@ -65,7 +81,9 @@ float JunoLFO::getNextSample() {
     }
     
     // Get LFO sample (sine wave)
-    float lfoSample = oscillator.processSample(0.0f);
+    float lfoSample = sinTurns(phase);
+    phase += phaseInc;
+    if (phase >= 1.0f) phase -= 1.0f;
     
     // Apply depth and delay envelope
     currentValue = lfoSample * depth * delayEnvelope;
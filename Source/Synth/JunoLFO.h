@@ -13,7 +13,8 @@
  * - Destinations: PWM, Filter, DCO (pitch), VCA (amplitude)
  * 
  * IMPLEMENTATION:
- * - Uses juce::dsp::Oscillator (JUCE standard component)
+ * - Phase accumulator + folded 9th-order sine polynomial (error < 4e-6):
+ *   plain floats, no lookup table or heap state per voice
  * - Modular architecture (separate from Voice)
  */
 class JunoLFO {
@@ -23,6 +24,9 @@ public:
     void prepare(double sampleRate, int maxBlockSize);
     void reset();
     
+    // Rate at which getNextSample() is called (audio rate, or a control tick)
+    void setUpdateRate(double updateRate);
+    
     // Parameters
     void setRate(float hz);          // 0.1 - 30 Hz
     void setDepth(float amount);     // 0 - 1
@@ -39,9 +43,13 @@ public:
     float getCurrentValue() const { return currentValue; }
     
 private:
-    juce::dsp::Oscillator<float> oscillator;
     double sampleRate = 44100.0;
     
+    // Sine phase (0-1) and its per-update increment
+    float phase = 0.0f;
+    float phaseInc = 0.0f;
+    void updatePhaseIncrement();
+    
     float rate = 5.0f;               // Hz
     float depth = 1.0f;              // 0-1
     float delay = 0.0f;              // seconds
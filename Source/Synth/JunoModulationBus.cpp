@@ -0,0 +1,83 @@
+// Source/Synth/JunoModulationBus.cpp
+#include "JunoModulationBus.h"
+
+JunoModulationBus::JunoModulationBus() {
+    constant.fill(true);
+}
+
+void JunoModulationBus::prepare(double sampleRate, int maxBlockSize) {
+    lanes.setSize(NumSources, juce::jmax(1, maxBlockSize));
+    lanes.clear();
+
+    for (auto& smoother : smoothers) {
+        smoother.reset(sampleRate, kRampSeconds);
+    }
+    reset();
+}
+
+void JunoModulationBus::reset() {
+    numEvents = 0;
+    hasOverflow.fill(false);
+    for (auto& smoother : smoothers) {
+        smoother.setCurrentAndTargetValue(0.0f);
+    }
+    constant.fill(true);
+}
+
+void JunoModulationBus::addEvent(Source source, int samplePosition, float value) {
+    const Event event { static_cast<int>(source), juce::jmax(0, samplePosition), value };
+    
+    if (numEvents < kMaxEvents) {
+        events[static_cast<size_t>(numEvents++)] = event;
+        return;
+    }
+    
+    // Queue full: the latest value of this source wins (other sources are untouched)
+    overflow[static_cast<size_t>(source)] = event;
+    hasOverflow[static_cast<size_t>(source)] = true;
+}
+
+void JunoModulationBus::render(int numSamples) {
+    // The processor splits longer host blocks; the lanes are never resized here
+    jassert(numSamples <= lanes.getNumSamples());
+    numSamples = juce::jmin(numSamples, lanes.getNumSamples());
+
+    for (int s = 0; s < NumSources; ++s) {
+        auto& smoother = smoothers[static_cast<size_t>(s)];
+        float* lane = lanes.getWritePointer(s);
+        bool hadEvents = false;
+        int pos = 0;
+
+        auto apply = [&](const Event& ev) {
+            int eventPos = juce::jmin(ev.samplePosition, numSamples);
+            fillLane(lane + pos, smoother, eventPos - pos);
+            pos = juce::jmax(pos, eventPos);
+            smoother.setTargetValue(ev.value);
+            hadEvents = true;
+        };
+
+        for (int e = 0; e < numEvents; ++e) {
+            if (events[static_cast<size_t>(e)].source == s) apply(events[static_cast<size_t>(e)]);
+        }
+        if (hasOverflow[static_cast<size_t>(s)]) apply(overflow[static_cast<size_t>(s)]);
+
+        constant[static_cast<size_t>(s)] = !hadEvents && !smoother.isSmoothing();
+        fillLane(lane + pos, smoother, numSamples - pos);
+    }
+
+    numEvents = 0;
+    hasOverflow.fill(false);
+}
+
+void JunoModulationBus::fillLane(float* dest, juce::SmoothedValue<float>& smoother, int numSamples) {
+    if (numSamples <= 0) return;
+
+    if (!smoother.isSmoothing()) {
+        juce::FloatVectorOperations::fill(dest, smoother.getCurrentValue(), numSamples);
+        return;
+    }
+
+    for (int i = 0; i < numSamples; ++i) {
+        dest[i] = smoother.getNextValue();
+    }
+}
@@ -0,0 +1,72 @@
+// Source/Synth/JunoModulationBus.h
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+
+/**
+ * JunoModulationBus - Sample-accurate performance controller lanes
+ *
+ * CHARACTERISTICS:
+ * - Pitch bend and modulation lever values arrive with their MIDI timestamp
+ * - Each source is rendered once per block into a per-sample lane
+ * - Short linear ramps between events (no zipper steps)
+ *
+ * IMPLEMENTATION:
+ * - Fixed-capacity event queue (no allocation on the audio thread). When it
+ *   is full, each source keeps its latest event in an overflow slot, so the
+ *   final value of every source survives
+ * - Lanes are sized in prepare(); render() never resizes them
+ * - Voices read the lanes directly; host parameters are mirrored lazily
+ *   by the processor, off the audio thread
+ */
+class JunoModulationBus {
+public:
+    enum Source {
+        Bender = 0,     // -1 to +1
+        ModWheel,       // 0 to 1 (LFO lever)
+        NumSources
+    };
+
+    JunoModulationBus();
+
+    void prepare(double sampleRate, int maxBlockSize);
+    void reset();
+
+    // Events must be added in time order (as MidiBuffer iterates)
+    void addEvent(Source source, int samplePosition, float value);
+
+    // Renders queued events into the lanes and clears the queue
+    // (numSamples must not exceed the prepared block size)
+    void render(int numSamples);
+
+    // Lane access (valid until the next render)
+    const float* getBuffer(Source source) const { return lanes.getReadPointer(source); }
+    bool isConstant(Source source) const { return constant[static_cast<size_t>(source)]; }
+    float getValue(Source source) const { return smoothers[static_cast<size_t>(source)].getCurrentValue(); }
+
+private:
+    struct Event {
+        int source = 0;
+        int samplePosition = 0;
+        float value = 0.0f;
+    };
+
+    static constexpr int kMaxEvents = 512;
+    static constexpr double kRampSeconds = 0.005; // 5ms: fast enough for vibrato by hand
+
+    std::array<Event, kMaxEvents> events;
+    int numEvents = 0;
+    
+    // Latest event per source that arrived with the queue full
+    std::array<Event, NumSources> overflow {};
+    std::array<bool, NumSources> hasOverflow {};
+
+    std::array<juce::SmoothedValue<float>, NumSources> smoothers;
+    std::array<bool, NumSources> constant {};
+    juce::AudioBuffer<float> lanes;
+
+    void fillLane(float* dest, juce::SmoothedValue<float>& smoother, int numSamples);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(JunoModulationBus)
+};
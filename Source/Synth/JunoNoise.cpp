@@ -0,0 +1,43 @@
+// Source/Synth/JunoNoise.cpp
+#include "JunoNoise.h"
+
+JunoNoise::JunoNoise(uint32_t s) {
+    setSeed(s);
+}
+
+void JunoNoise::setSeed(uint32_t s) {
+    seed = s;
+    reset();
+}
+
+void JunoNoise::reset() {
+    // Decorrelate the lanes (splitmix32-style scramble). xorshift must not start at 0
+    uint32_t z = seed;
+    for (auto& lane : state) {
+        z += 0x9E3779B9u;
+        uint32_t x = z;
+        x = (x ^ (x >> 16)) * 0x85EBCA6Bu;
+        x = (x ^ (x >> 13)) * 0xC2B2AE35u;
+        x ^= x >> 16;
+        lane = (x != 0) ? x : 0x6D2B79F5u;
+    }
+    nextLane = 0;
+}
+
+void JunoNoise::fill(float* output, int numSamples) {
+    int i = 0;
+    for (; i + kNumLanes <= numSamples; i += kNumLanes) {
+        for (int j = 0; j < kNumLanes; ++j) {
+            output[i + j] = toBipolar(step(state[(size_t)j]));
+        }
+    }
+    for (; i < numSamples; ++i) {
+        output[i] = getNextSample();
+    }
+}
+
+float JunoNoise::getNextSample() {
+    float value = toBipolar(step(state[(size_t)nextLane]));
+    nextLane = (nextLane + 1) % kNumLanes;
+    return value;
+}
@@ -0,0 +1,55 @@
+// Source/Synth/JunoNoise.h
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * JunoNoise - White noise source
+ * 
+ * CHARACTERISTICS:
+ * - Uniform white noise, -1 to +1
+ * - One source can feed every voice (the Juno-106 has a single noise
+ *   generator shared by all six voice chips)
+ * - Seedable: the same seed gives the same sequence (deterministic renders)
+ * 
+ * IMPLEMENTATION:
+ * - 4 independent xorshift32 lanes, filled a block at a time
+ *   (no serial dependency between lanes, so the loop vectorises)
+ * - Float conversion by writing the mantissa bits (no int-to-float divide)
+ */
+class JunoNoise {
+public:
+    explicit JunoNoise(uint32_t seed = 1984);
+    
+    void setSeed(uint32_t seed);
+    void reset();                    // Restart the sequence from the seed
+    
+    // Processing
+    void fill(float* output, int numSamples);
+    float getNextSample();           // Single value (slow paths, e.g. drift targets)
+    
+private:
+    static constexpr int kNumLanes = 4;
+    
+    uint32_t seed = 1984;
+    std::array<uint32_t, kNumLanes> state {};
+    int nextLane = 0;
+    
+    static inline uint32_t step(uint32_t& x) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        return x;
+    }
+    
+    static inline float toBipolar(uint32_t x) {
+        // 23 random mantissa bits in [1, 2), mapped to [-1, 1)
+        uint32_t bits = (x >> 9) | 0x3F800000u;
+        float f;
+        std::memcpy(&f, &bits, sizeof(f));
+        return f * 2.0f - 3.0f;
+    }
+};
@@ -0,0 +1,124 @@
+// Source/Synth/JunoOversampler.cpp
+#include "JunoOversampler.h"
+#include <cmath>
+
+namespace {
+    // Elliptic half-band design (closed form, see HIIR PolyphaseIir2Designer)
+    void computeTransitionParam(double transition, double& k, double& q) {
+        k = std::tan((1.0 - transition * 2.0) * juce::MathConstants<double>::pi / 4.0);
+        k *= k;
+        const double kksqrt = std::pow(1.0 - k * k, 0.25);
+        const double e = 0.5 * (1.0 - kksqrt) / (1.0 + kksqrt);
+        const double e2 = e * e;
+        const double e4 = e2 * e2;
+        q = e * (1.0 + e4 * (2.0 + e4 * (15.0 + 150.0 * e4)));
+    }
+    
+    double computeAccNum(double q, int order, int c) {
+        double result = 0.0, term = 0.0;
+        int i = 0, j = 1;
+        do {
+            term = std::pow(q, i * (i + 1)) * std::sin((i * 2 + 1) * c * juce::MathConstants<double>::pi / order) * j;
+            result += term;
+            j = -j;
+            ++i;
+        } while (std::abs(term) > 1e-100);
+        return result;
+    }
+    
+    double computeAccDen(double q, int order, int c) {
+        double result = 0.0, term = 0.0;
+        int i = 1, j = -1;
+        do {
+            term = std::pow(q, i * i) * std::cos(i * 2 * c * juce::MathConstants<double>::pi / order) * j;
+            result += term;
+            j = -j;
+            ++i;
+        } while (std::abs(term) > 1e-100);
+        return result;
+    }
+}
+
+//==============================================================================
+void JunoOversampler::HalfBand::design(double attenuationDb, double transitionBandwidth) {
+    double k = 0.0, q = 0.0;
+    computeTransitionParam(transitionBandwidth, k, q);
+    
+    // Filter order from the stopband attenuation
+    const double attnP2 = std::pow(10.0, -attenuationDb / 10.0);
+    const double a = attnP2 / (1.0 - attnP2);
+    int order = static_cast<int>(std::ceil(std::log(a * a / 16.0) / std::log(q)));
+    if ((order & 1) == 0) ++order;
+    if (order == 1) order = 3;
+    numCoefs = juce::jmin(kMaxCoefs, (order - 1) / 2);
+    
+    for (int index = 0; index < numCoefs; ++index) {
+        const int c = index + 1;
+        const double num = computeAccNum(q, order, c) * std::pow(q, 0.25);
+        const double den = computeAccDen(q, order, c) + 0.5;
+        const double ww = num / den;
+        const double wwsq = ww * ww;
+        const double xx = std::sqrt((1.0 - wwsq * k) * (1.0 - wwsq / k)) / (1.0 + wwsq);
+        coefs[(size_t)index] = static_cast<float>((1.0 - xx) / (1.0 + xx));
+    }
+    reset();
+}
+
+void JunoOversampler::HalfBand::reset() {
+    x.fill(0.0f);
+    y.fill(0.0f);
+}
+
+void JunoOversampler::HalfBand::process(const float* input, float* output, int numOutput) {
+    for (int n = 0; n < numOutput; ++n) {
+        // Path 0 takes the odd input, path 1 the even one; stages alternate paths
+        float path0 = input[2 * n + 1];
+        float path1 = input[2 * n];
+        
+        for (int i = 0; i < numCoefs; i += 2) {
+            const float x0 = x[(size_t)i];
+            x[(size_t)i] = path0;
+            path0 = (path0 - y[(size_t)i]) * coefs[(size_t)i] + x0;
+            y[(size_t)i] = path0;
+            
+            if (i + 1 < numCoefs) {
+                const float x1 = x[(size_t)i + 1];
+                x[(size_t)i + 1] = path1;
+                path1 = (path1 - y[(size_t)i + 1]) * coefs[(size_t)i + 1] + x1;
+                y[(size_t)i + 1] = path1;
+            }
+        }
+        
+        output[n] = 0.5f * (path0 + path1);
+    }
+}
+
+//==============================================================================
+JunoOversampler::JunoOversampler() {
+    // Same designs for every decimator of every instance: computed once per process
+    static const HalfBand designed2x = [] { HalfBand h; h.design(96.0, 0.04); return h; }();   // 8 coefficients
+    static const HalfBand designed4x = [] { HalfBand h; h.design(90.0, 0.25); return h; }();   // 4 coefficients
+    stage2x = designed2x;
+    stage4x = designed4x;
+}
+
+void JunoOversampler::reset() {
+    stage2x.reset();
+    stage4x.reset();
+}
+
+void JunoOversampler::setFactor(int newFactor) {
+    newFactor = newFactor >= 4 ? 4 : (newFactor >= 2 ? 2 : 1);
+    if (newFactor == factor) return;
+    factor = newFactor;
+    reset();
+}
+
+void JunoOversampler::decimate(float* data, int numOutputSamples) {
+    if (factor == 4) {
+        stage4x.process(data, data, numOutputSamples * 2);
+    }
+    if (factor >= 2) {
+        stage2x.process(data, data, numOutputSamples);
+    }
+}
@@ -0,0 +1,59 @@
+// Source/Synth/JunoOversampler.h
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+
+/**
+ * JunoOversampler - Decimator for the oversampled voice bus
+ * 
+ * CHARACTERISTICS:
+ * - 1x / 2x / 4x (quality tiers)
+ * - Voices render directly at the oversampled rate, so only the way down
+ *   is needed: one decimator on the mono voice bus, not one per voice
+ * - 2x -> 1x: >= 96 dB stopband, flat to 0.46 fs (20.3 kHz at 44.1 kHz)
+ * - 4x -> 2x: >= 90 dB where it would fold into the audio band
+ * 
+ * IMPLEMENTATION:
+ * - Polyphase IIR half-band filters (two first-order allpass chains in z^-2,
+ *   Laurent de Soras' HIIR structure); coefficients are designed from
+ *   attenuation and transition bandwidth once per process and copied
+ * - In-place, no allocation
+ */
+class JunoOversampler {
+public:
+    static constexpr int kMaxFactor = 4;
+    
+    JunoOversampler();
+    
+    void reset();
+    
+    // 1, 2 or 4
+    void setFactor(int factor);
+    int getFactor() const { return factor; }
+    
+    // data holds numOutputSamples * factor samples; the first numOutputSamples
+    // are overwritten with the decimated signal
+    void decimate(float* data, int numOutputSamples);
+    
+private:
+    class HalfBand {
+    public:
+        void design(double attenuationDb, double transitionBandwidth);
+        void reset();
+        
+        // numOutput samples from numOutput * 2 inputs (in place allowed)
+        void process(const float* input, float* output, int numOutput);
+        
+    private:
+        static constexpr int kMaxCoefs = 12;
+        int numCoefs = 0;
+        std::array<float, kMaxCoefs> coefs {};
+        std::array<float, kMaxCoefs> x {};
+        std::array<float, kMaxCoefs> y {};
+    };
+    
+    HalfBand stage2x;   // 2x -> 1x (steep)
+    HalfBand stage4x;   // 4x -> 2x (relaxed, only guards the audio band)
+    int factor = 1;
+};
@@ -0,0 +1,160 @@
+// Source/Synth/JunoSaturation.h
+#pragma once
+
+#include <cmath>
+
+/**
+ * JunoSaturation - Antiderivative anti-aliased (ADAA) waveshapers
+ *
+ * A static nonlinearity f(x) aliases because its output spectrum is wider
+ * than the input's. ADAA replaces f(x[n]) by the average of f over the
+ * segment between consecutive inputs, taken from its antiderivatives:
+ *
+ *   1st order: y = (F1(x[n]) - F1(x[n-1])) / (x[n] - x[n-1])
+ *   2nd order: the same divided difference applied again on F2
+ *
+ * That kills most of the folded-back energy without oversampling, at the
+ * cost of half a sample (1st) or one sample (2nd) of delay and a gentle HF
+ * roll-off. Ill-conditioned steps (x[n] ~ x[n-1]) fall back to evaluating
+ * the shape at the midpoint.
+ *
+ * SHAPES (each provides f, F1 and, where cheap, F2):
+ * - Tanh:     f = tanh(x), F1 = log(cosh(x)) (overflow-safe form). No F2 (it
+ *             needs the dilogarithm), so 1st order only - the ladder stages
+ * - SoftClip: f = x - x^3/3 for |x| <= 1, +/-2/3 beyond (cubic soft clipper,
+ *             C1 continuous). Piecewise polynomial F1 and F2 - output stage
+ */
+namespace JunoSaturation
+{
+    //==============================================================================
+    // Shapes are templated so the ADAA divided differences can run in double
+    struct Tanh
+    {
+        template <typename T>
+        static T f(T x) { return std::tanh(x); }
+
+        // log(cosh(x)) = |x| + log(1 + e^-2|x|) - log(2)
+        template <typename T>
+        static T F1(T x)
+        {
+            const T ax = std::abs(x);
+            return ax + std::log1p(std::exp(T(-2) * ax)) - T(0.69314718055994531);
+        }
+    };
+
+    struct SoftClip
+    {
+        template <typename T>
+        static T f(T x)
+        {
+            if (x >= T(1)) return T(2) / T(3);
+            if (x <= T(-1)) return T(-2) / T(3);
+            return x - x * x * x / T(3);
+        }
+
+        // Even: x^2/2 - x^4/12 inside, 2|x|/3 - 1/4 beyond
+        template <typename T>
+        static T F1(T x)
+        {
+            const T ax = std::abs(x);
+            if (ax >= T(1)) return ax * T(2) / T(3) - T(0.25);
+            const T x2 = x * x;
+            return x2 * T(0.5) - x2 * x2 / T(12);
+        }
+
+        // Odd: x^3/6 - x^5/60 inside, 3/20 + (x^2 - 1)/3 - (|x| - 1)/4 beyond
+        template <typename T>
+        static T F2(T x)
+        {
+            const T ax = std::abs(x);
+            if (ax >= T(1)) {
+                const T v = T(0.15) + (ax * ax - T(1)) / T(3) - (ax - T(1)) * T(0.25);
+                return x < T(0) ? -v : v;
+            }
+            const T x2 = x * x;
+            return x * x2 / T(6) - x * x2 * x2 / T(60);
+        }
+    };
+
+    //==============================================================================
+    // First-order ADAA (half a sample of delay). F1 grows like |x|, so in float
+    // F1(x) - F1(x[n-1]) cancels to ~1e-3 at large inputs: it runs in double
+    template <typename Shape>
+    class ADAA1
+    {
+    public:
+        void reset() { x1 = 0.0; f1 = 0.0; }
+
+        float process(float input)
+        {
+            constexpr double kTolerance = 1.0e-5;
+            const double x = input;
+            const double F = Shape::F1(x);
+            const double dx = x - x1;
+            const double y = std::abs(dx) < kTolerance ? Shape::f(0.5 * (x + x1))
+                                                       : (F - f1) / dx;
+            x1 = x;
+            f1 = F;
+            return static_cast<float>(y);
+        }
+
+        void process(float* data, int numSamples)
+        {
+            for (int i = 0; i < numSamples; ++i) data[i] = process(data[i]);
+        }
+
+    private:
+        double x1 = 0.0;     // x[n-1]
+        double f1 = 0.0;     // F1(x[n-1])
+    };
+
+    // Second-order ADAA (one sample of delay), shapes with F2 only, in double
+    // like ADAA1
+    template <typename Shape>
+    class ADAA2
+    {
+    public:
+        void reset() { x1 = x2 = 0.0; f2 = 0.0; d1 = 0.0; }
+
+        float process(float input)
+        {
+            constexpr double kTolerance = 1.0e-5;
+            const double x = input;
+            const double F = Shape::F2(x);
+
+            // First divided difference of F2 over [x[n-1], x[n]]
+            const double dx = x - x1;
+            const double d = std::abs(dx) < kTolerance ? Shape::F1(0.5 * (x + x1))
+                                                       : (F - f2) / dx;
+
+            double y;
+            const double span = x - x2;
+            if (std::abs(span) >= kTolerance) {
+                y = 2.0 * (d - d1) / span;
+            } else {
+                // x[n] ~ x[n-2]: expand around their midpoint instead
+                const double xBar = 0.5 * (x + x2);
+                const double delta = xBar - x1;
+                y = std::abs(delta) < kTolerance
+                        ? Shape::f(0.5 * (xBar + x1))
+                        : (2.0 / delta) * (Shape::F1(xBar) + (Shape::F2(x1) - Shape::F2(xBar)) / delta);
+            }
+
+            x2 = x1;
+            x1 = x;
+            f2 = F;
+            d1 = d;
+            return static_cast<float>(y);
+        }
+
+        void process(float* data, int numSamples)
+        {
+            for (int i = 0; i < numSamples; ++i) data[i] = process(data[i]);
+        }
+
+    private:
+        double x1 = 0.0, x2 = 0.0;   // x[n-1], x[n-2]
+        double f2 = 0.0;             // F2(x[n-1])
+        double d1 = 0.0;             // Previous first divided difference
+    };
+}
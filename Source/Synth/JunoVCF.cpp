@@ -0,0 +1,75 @@
+// Source/Synth/JunoVCF.cpp
+#include "JunoVCF.h"
+#include "JunoFastMath.h"
+#include <cmath>
+
+JunoVCF::JunoVCF() {
+    setDrive(1.0f);
+    setResonance(0.0f);
+    setCutoffFrequencyHz(cutoffHz);
+    a1.snap();
+    resonance.snap();
+}
+
+void JunoVCF::prepare(double sr) {
+    sampleRate = sr;
+    rampSamples = static_cast<int>(std::floor(kSmoothingSeconds * sr));
+    setCutoffFrequencyHz(cutoffHz);
+    reset();
+}
+
+void JunoVCF::setSampleRate(double sr) {
+    sampleRate = sr;
+    rampSamples = static_cast<int>(std::floor(kSmoothingSeconds * sr));
+    setCutoffFrequencyHz(cutoffHz);
+}
+
+void JunoVCF::reset() {
+    state.fill(0.0f);
+    inputShaper.reset();
+    a1.snap();
+    resonance.snap();
+}
+
+void JunoVCF::setCutoffFrequencyHz(float hz) {
+    cutoffHz = hz;
+    a1.setTarget(JunoFastMath::exp(-juce::MathConstants<float>::twoPi * hz / static_cast<float>(sampleRate)), rampSamples);
+}
+
+void JunoVCF::setResonance(float amount) {
+    resonance.setTarget(juce::jmap(juce::jlimit(0.0f, 1.1f, amount), 0.1f, 1.0f), rampSamples);
+}
+
+void JunoVCF::setDrive(float amount) {
+    drive = juce::jmax(1.0f, amount);
+    gain = std::pow(drive, -2.642f) * 0.6103f + 0.3903f;
+    drive2 = drive * 0.04f + 0.96f;
+    gain2 = std::pow(drive2, -2.642f) * 0.6103f + 0.3903f;
+}
+
+void JunoVCF::process(float* data, int numSamples) {
+    auto& s = state;
+
+    for (int i = 0; i < numSamples; ++i) {
+        // Per-sample smoothing, as LadderFilter::updateSmoothers()
+        const float p = a1.next();
+        const float res = resonance.next();
+        const float g = 1.0f - p;
+        const float b0 = g * 0.76923076923f;
+        const float b1 = g * 0.23076923076f;
+
+        const float dx = gain * inputShaper.process(drive * data[i]);
+        // Plain tanh on purpose, not ADAA: the half-sample ADAA delay would sit
+        // inside the resonance loop and detune self-oscillation (see header)
+        const float fb = gain2 * std::tanh(drive2 * s[4]);
+        const float a = dx - 4.0f * res * (fb - dx * kComp);
+
+        const float b = b1 * s[0] + p * s[1] + b0 * a;
+        const float c = b1 * s[1] + p * s[2] + b0 * b;
+        const float d = b1 * s[2] + p * s[3] + b0 * c;
+        const float e = b1 * s[3] + p * s[4] + b0 * d;
+
+        s[0] = a; s[1] = b; s[2] = c; s[3] = d; s[4] = e;
+        data[i] = e;
+    }
+}
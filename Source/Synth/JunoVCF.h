@@ -0,0 +1,79 @@
+// Source/Synth/JunoVCF.h
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include "JunoSaturation.h"
+
+/**
+ * JunoVCF - IR3109 4-pole lowpass (24 dB/oct) with anti-aliased drive
+ *
+ * CHARACTERISTICS:
+ * - Same ladder topology, coefficients and drive/resonance response as
+ *   juce::dsp::LadderFilter in LPF24 mode (the sound the engine was voiced
+ *   with): four one-pole stages, resonance fed back from the last stage
+ * - Input drive and the feedback path are tanh stages
+ *
+ * IMPLEMENTATION:
+ * - The input tanh is first-order ADAA (JunoSaturation::Tanh), so the drive
+ *   does not alias without oversampling. Its half-sample delay sits outside
+ *   the loop. The feedback tanh stays a plain (memoryless) tanh: ADAA there
+ *   would add half a sample to the loop delay and move the self-oscillation
+ *   pitch and resonance amount away from the LadderFilter reference
+ * - Cutoff and resonance are smoothed per sample with the same 50 ms linear
+ *   ramps as LadderFilter; the voice sets the cutoff at control rate
+ * - Mono, in-place block processing
+ */
+class JunoVCF {
+public:
+    JunoVCF();
+
+    void prepare(double sampleRate);
+    void setSampleRate(double sampleRate);   // Keeps the filter state and ramps
+    void reset();
+
+    void setCutoffFrequencyHz(float hz);
+    void setResonance(float amount);   // 0 - 1 (slightly above self-oscillates)
+    void setDrive(float amount);       // >= 1
+
+    void process(float* data, int numSamples);
+
+private:
+    double sampleRate = 44100.0;
+    float cutoffHz = 5500.0f;
+
+    // Linear ramp (juce::SmoothedValue, Linear)
+    struct Ramp {
+        float current = 0.0f, target = 0.0f, step = 0.0f;
+        int countdown = 0;
+        
+        void setTarget(float value, int rampSamples) {
+            target = value;
+            countdown = rampSamples;
+            if (countdown <= 0) { current = target; return; }
+            step = (target - current) / static_cast<float>(countdown);
+        }
+        void snap() { current = target; countdown = 0; }
+        float next() {
+            if (countdown <= 0) return target;
+            current = --countdown == 0 ? target : current + step;
+            return current;
+        }
+    };
+    
+    static constexpr double kSmoothingSeconds = 0.05;   // LadderFilter default
+    int rampSamples = 0;
+    
+    // One-pole coefficient and resonance (juce::dsp::LadderFilter mapping)
+    Ramp a1, resonance;
+
+    // Drive: tanh pre-gain and make-up, input and feedback
+    float drive = 1.0f, gain = 1.0f;
+    float drive2 = 1.0f, gain2 = 1.0f;
+
+    // Feedback input, four stage outputs
+    std::array<float, 5> state {};
+    JunoSaturation::ADAA1<JunoSaturation::Tanh> inputShaper;
+
+    static constexpr float kComp = 0.5f;   // Passband compensation (LPF)
+};
@@ -0,0 +1,32 @@
+// Source/Synth/JunoWavetables.cpp
+#include "JunoWavetables.h"
+#include <cmath>
+#include <vector>
+
+const JunoWavetables& JunoWavetables::get() {
+    static const JunoWavetables instance;
+    return instance;
+}
+
+JunoWavetables::JunoWavetables() {
+    // One cycle of sin, indexed by (harmonic * n) mod N
+    std::vector<double> sine(kTableSize);
+    for (int n = 0; n < kTableSize; ++n) {
+        sine[(size_t)n] = std::sin(juce::MathConstants<double>::twoPi * n / kTableSize);
+    }
+    
+    // Rising ramp 2p - 1 = -(2 / pi) * sum(sin(2 pi h p) / h)
+    for (int level = 0; level < kNumLevels; ++level) {
+        const int numHarmonics = (kTableSize / 2) >> level;
+        auto& table = tables[(size_t)level];
+        
+        for (int n = 0; n < kTableSize; ++n) {
+            double sum = 0.0;
+            for (int h = 1; h <= numHarmonics; ++h) {
+                sum += sine[(size_t)((h * n) & (kTableSize - 1))] / h;
+            }
+            table[(size_t)n] = static_cast<float>(-sum * 2.0 / juce::MathConstants<double>::pi);
+        }
+        table[kTableSize] = table[0]; // Guard point for interpolation
+    }
+}
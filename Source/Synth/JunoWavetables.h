@@ -0,0 +1,57 @@
+// Source/Synth/JunoWavetables.h
+#pragma once
+
+#include <JuceHeader.h>
+#include "JunoFastMath.h"
+#include <array>
+
+/**
+ * JunoWavetables - Band-limited DCO waveforms, shared by every voice
+ * 
+ * CHARACTERISTICS:
+ * - Mipmapped band-limited sawtooth, one level per octave
+ * - Level chosen from the phase increment: the highest harmonic always
+ *   stays between sr/4 and sr/2 (no aliasing, full bandwidth within an octave)
+ * - Pulse and sub are differences of two saw reads (no extra tables):
+ *     pulse(p) = saw(p - pw) - saw(p) + 2pw - 1
+ *     sub(q)   = saw(q) - saw(q - 1/2)        (q = half-rate phase)
+ * 
+ * IMPLEMENTATION:
+ * - Immutable, built once per process on first use (thread-safe static)
+ *   and shared by reference across all voices and plugin instances
+ * - 11 levels x 2048 samples + guard point (~90 KB total)
+ * - Linear interpolation
+ */
+class JunoWavetables {
+public:
+    static constexpr int kTableSize = 2048;
+    static constexpr int kNumLevels = 11;          // 1024 harmonics down to 1
+    
+    // Process-wide instance
+    static const JunoWavetables& get();
+    
+    // Mipmap level for a phase increment (cycles per sample)
+    int getLevel(float phaseIncrement) const {
+        // floor(log2(dt * N)) + 1, read from the float exponent bits
+        float x = phaseIncrement * static_cast<float>(kTableSize);
+        int exponent = static_cast<int>((JunoFastMath::floatToBits(x) >> 23) & 0xFF) - 127;
+        return juce::jlimit(0, kNumLevels - 1, exponent + 1);
+    }
+    
+    // Band-limited saw, -1 to +1 (rising ramp), phase 0-1
+    float saw(int level, float phase) const {
+        const float* table = tables[(size_t)level].data();
+        float position = phase * static_cast<float>(kTableSize);
+        int index = static_cast<int>(position);
+        float frac = position - static_cast<float>(index);
+        index &= (kTableSize - 1);
+        return table[index] + frac * (table[index + 1] - table[index]);
+    }
+    
+private:
+    JunoWavetables();
+    
+    std::array<std::array<float, kTableSize + 1>, kNumLevels> tables;
+    
+    JUCE_DECLARE_NON_COPYABLE(JunoWavetables)
+};
@@ -1,10 +1,10 @@
 #include "Voice.h"
+#include "JunoFastMath.h"
 #include <cmath>
 
 Voice::Voice() {
     // Initialize filter with Juno-106 characteristics
     // IR3109 is a 4-pole (24dB/oct) lowpass
-    filter.setMode(juce::dsp::LadderFilterMode::LPF24);
     filter.setResonance(0.0f);
     filter.setCutoffFrequencyHz(5500.0f);  // Authentic Juno default
     filter.setDrive(1.2f);  // Slight drive for analog warmth
@@ -16,43 +16,69 @@ void Voice::prepare(double sr, int maxBlockSize) {
     // Setup DCO (Juno-106)
     dco.prepare(sr, maxBlockSize);
     
-    juce::dsp::ProcessSpec spec;
-    spec.sampleRate = sr;
-    spec.maximumBlockSize = static_cast<juce::uint32>(maxBlockSize);
-    spec.numChannels = 1;
-    
     // Setup ADSR (Juno-106)
     adsr.setSampleRate(sr);
     
-    filter.prepare(spec);
-    filter.reset();
+    filter.prepare(sr);
     
     // Setup HPF (Juno-106)
-    hpFilter.prepare(spec);
-    hpFilter.reset();
+    hot.hpf.reset();
     updateHPF();
     
     // Setup LFO (Juno-106)
     lfo.prepare(sr, maxBlockSize);
+    
+    hot.controlPhase = 0;
+    
+    // ADSR/LFO update rate (audio rate or control tick)
+    updateControlRate(true);
+}
+
+void Voice::setSampleRate(double sr) {
+    if (sr == sampleRate) return;
+    sampleRate = sr;
+    
+    dco.setSampleRate(sr);
+    filter.setSampleRate(sr);
+    updateHPF();          // Coefficients only, the biquad state is kept
+    
+    // Glide coefficient is per sample
+    float glideSamples = params.portamentoTime * 5.0f * static_cast<float>(sampleRate);
+    hot.glideCoeff = glideSamples > 1.0f ? 1.0f - JunoFastMath::exp(-3.0f / glideSamples) : 1.0f;
+    
+    // ADSR/LFO increments; both continue from their current values
+    updateControlRate(true);
+}
+
+void Voice::setOversamplingFactor(int factor) {
+    hot.laneShift = factor >= 4 ? 2 : (factor >= 2 ? 1 : 0);
+    hot.controlInterval = kControlInterval << hot.laneShift;
+    hot.controlPhase = 0;
 }
 
 void Voice::noteOn(int midiNote, float vel) {
-    currentNote = midiNote;
-    velocity = vel;
-    
-    // Calculate target frequency
-    targetFrequency = 440.0f * std::pow(2.0f, (midiNote - 69) / 12.0f);
-    // Portamento: if enabled, glide from current to target
-    if (params.portamentoOn && adsr.isActive()) {
-        // Keep current frequency, will glide to target
-        // currentFrequency is already set from previous note, will glide to targetFrequency
+    // Portamento: glide from the pitch currently sounding. The glide is an
+    // offset in semitones (exponential in Hz) that decays per sample.
+    if (params.portamentoOn && adsr.isActive() && hot.currentNote >= 0) {
+        hot.glideSemitones += static_cast<float>(hot.currentNote - midiNote);
     } else {
-        // Jump immediately to target
-        currentFrequency = targetFrequency;
+        hot.glideSemitones = 0.0f; // Jump immediately to target
     }
     
-    // Set DCO frequency
-    dco.setFrequency(currentFrequency);
+    hot.currentNote = midiNote;
+    hot.velocity = vel;
+    
+    // Note frequency (tune, glide, bender and LFO are applied per sample as pitch modulation)
+    noteFrequency = JunoFastMath::midiNoteToHz(midiNote);
+    dco.setFrequency(noteFrequency);
+    
+    // Start a fresh control tick so the attack is not delayed
+    hot.tickCountdown = 0;
+    
+    // A retiring voice that is reused plays at full level again
+    hot.tailFadeGain = 1.0f;
+    hot.tailFadeStep = 0.0f;
+    hot.outputPeak = 0.0f;
     
     // Trigger ADSR
     adsr.noteOn();
@@ -76,13 +102,11 @@ void Voice::updateParams(const SynthParams& p) {
     dco.setNoiseLevel(p.noiseLevel);
     dco.setPWM(juce::jlimit(0.0f, 0.95f, p.pwmAmount + variance.pwOffset));
     dco.setPWMMode(static_cast<JunoDCO::PWMMode>(p.pwmMode));
-    dco.setLFODepth(p.lfoToDCO);
-    dco.setDrift(p.drift);
     
     // Update ADSR (Spec: 1.5ms to 3s/12s) - Normalized input to Log scaling
-    float attackTime = 0.0015f * std::pow(3.0f / 0.0015f, p.attack);
-    float decayTime = 0.0015f * std::pow(12.0f / 0.0015f, p.decay);
-    float releaseTime = 0.0015f * std::pow(12.0f / 0.0015f, p.release);
+    float attackTime = JunoFastMath::logScale(p.attack, 0.0015f, JunoFastMath::kLog2AttackRange);
+    float decayTime = JunoFastMath::logScale(p.decay, 0.0015f, JunoFastMath::kLog2DecayRange);
+    float releaseTime = JunoFastMath::logScale(p.release, 0.0015f, JunoFastMath::kLog2DecayRange);
 
     adsr.setAttack(attackTime * variance.envTimeScale);
     adsr.setDecay(decayTime * variance.envTimeScale);
@@ -91,16 +115,42 @@ void Voice::updateParams(const SynthParams& p) {
     adsr.setGateMode(p.vcaMode == 1);
     
     // IR3109 resonance: self oscillation push (Normalize 0-1 to internal range)
-    filter.setResonance(juce::jlimit(0.0f, 10.0f, p.resonance * 1.05f * variance.filterResScale)); 
+    filter.setResonance(juce::jlimit(0.0f, 1.1f, p.resonance * 1.05f * variance.filterResScale)); 
     
     // Update HPF
     updateHPF();
     
     // Update LFO (Spec: 0.1Hz to 30Hz, 3s Delay)
-    float lfoRateHz = 0.1f * std::pow(30.0f / 0.1f, p.lfoRate);
+    float lfoRateHz = JunoFastMath::logScale(p.lfoRate, 0.1f, JunoFastMath::kLog2LFORange);
     lfo.setRate(lfoRateHz);
     lfo.setDepth(1.0f); 
     lfo.setDelay(p.lfoDelay * 3.0f);
+    
+    // Portamento (0-5s). Same curve as the ADSR: ~95% of the interval in glideTime
+    float glideSamples = p.portamentoTime * 5.0f * static_cast<float>(sampleRate);
+    hot.glideCoeff = glideSamples > 1.0f ? 1.0f - JunoFastMath::exp(-3.0f / glideSamples) : 1.0f;
+    if (!p.portamentoOn) hot.glideSemitones = 0.0f;
+    
+    updateControlRate();
+}
+
+void Voice::updateControlRate(bool force) {
+    int tick = 0;
+    if (params.controlRateMs > 0) {
+        tick = juce::jmax(1, juce::roundToInt(params.controlRateMs * 0.001 * sampleRate));
+    }
+    if (tick == hot.controlTickSamples && !force) return;
+    
+    hot.controlTickSamples = tick;
+    const double updateRate = tick > 0 ? sampleRate / tick : sampleRate;
+    adsr.setSampleRate(updateRate);
+    lfo.setUpdateRate(updateRate);
+    
+    // Continue from the current values
+    hot.tickCountdown = 0;
+    hot.envValue = hot.envTarget = adsr.getCurrentValue();
+    hot.lfoValue = hot.lfoTarget = lfo.getCurrentValue();
+    hot.envStep = hot.lfoStep = 0.0f;
 }
 
 void Voice::updateHPF() {
@@ -114,98 +164,184 @@ void Voice::updateHPF() {
         case 3: cutoffFreq = 720.0f; break;   // Position 3
     }
     
-    hpFilter.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighPass(sampleRate, cutoffFreq);
+    // 2nd-order Butterworth (same response as juce::dsp::IIR::Coefficients::makeHighPass)
+    const double n = std::tan(juce::MathConstants<double>::pi * cutoffFreq / sampleRate);
+    const double n2 = n * n;
+    const double invQ = juce::MathConstants<double>::sqrt2;
+    const double c1 = 1.0 / (1.0 + invQ * n + n2);
+    
+    hot.hpf.b0 = static_cast<float>(c1);
+    hot.hpf.b1 = static_cast<float>(-2.0 * c1);
+    hot.hpf.b2 = static_cast<float>(c1);
+    hot.hpf.a1 = static_cast<float>(c1 * 2.0 * (n2 - 1.0));
+    hot.hpf.a2 = static_cast<float>(c1 * (1.0 - invQ * n + n2));
 }
 
 void Voice::renderNextBlock(juce::AudioBuffer<float>& buffer, int startSample, int numSamples) {
     if (!adsr.isActive()) return;
     
-    // Portamento: smooth glide to target frequency
-    if (params.portamentoOn && std::abs(currentFrequency - targetFrequency) > 0.1f) {
-        float glideTime = params.portamentoTime * 5.0f;
-        float glideRate = 1.0f / (glideTime * static_cast<float>(sampleRate));
-        
-        if (currentFrequency < targetFrequency) {
-            currentFrequency += (targetFrequency - currentFrequency) * glideRate;
-        } else {
-            currentFrequency -= (currentFrequency - targetFrequency) * glideRate;
-        }
-    } else {
-        currentFrequency = targetFrequency;
+    // Fixed sub-blocks: each one goes DCO -> HPF -> VCF -> VCA -> bus while
+    // its scratch is still in L1, whatever the host block size
+    float peak = 0.0f;
+    for (int pos = 0; pos < numSamples; pos += kSubBlockSize) {
+        peak = juce::jmax(peak, renderSubBlock(buffer, startSample + pos, juce::jmin(kSubBlockSize, numSamples - pos)));
+        if (!adsr.isActive() || (hot.tailFadeStep > 0.0f && hot.tailFadeGain <= 0.0f)) break; // Finished mid-block
     }
+    hot.outputPeak = peak;
     
-    // Apply bender and master tune to DCO
-    float bendedFrequency = currentFrequency;
-    bendedFrequency *= std::pow(2.0f, params.tune / 1200.0f);
-
-    if (params.benderValue != 0.0f && params.benderToDCO > 0.0f) {
-        float bendSemitones = params.benderValue * params.benderToDCO * 12.0f;
-        bendedFrequency *= std::pow(2.0f, bendSemitones / 12.0f);
+    // Silent-tail culling: retire once the fade is done; start the fade when a
+    // whole block of the release stayed below the floor
+    if (hot.tailFadeStep > 0.0f) {
+        if (hot.tailFadeGain <= 0.0f) {
+            adsr.reset();
+            hot.tailFadeGain = 1.0f;
+            hot.tailFadeStep = 0.0f;
+        }
+    } else if (hot.tailFloor > 0.0f && isReleasing() && hot.outputPeak < hot.tailFloor) {
+        hot.tailFadeStep = 1.0f / juce::jmax(1.0f, kTailFadeSeconds * static_cast<float>(sampleRate));
     }
-    
-    dco.setFrequency(bendedFrequency);
+}
+
+float Voice::renderSubBlock(juce::AudioBuffer<float>& buffer, int startSample, int numSamples) {
+    // Performance controllers (sample-accurate lanes, or the block value when unconnected)
+    const float* benderLane = modBus != nullptr ? modBus->getBuffer(JunoModulationBus::Bender) + (startSample >> hot.laneShift) : nullptr;
+    const float* modWheelLane = modBus != nullptr ? modBus->getBuffer(JunoModulationBus::ModWheel) + (startSample >> hot.laneShift) : nullptr;
     
     // Base VCF cutoff (10Hz to 24kHz authentic range)
-    float baseCutoff = 10.0f * std::pow(24000.0f / 10.0f, params.vcfFreq);
-    if (params.kybdTracking > 0.0f) {
-        float semitones = static_cast<float>(currentNote) - 60.0f;
-        baseCutoff *= std::pow(2.0f, (semitones * params.kybdTracking) / 12.0f);
+    float baseCutoff = JunoFastMath::logScale(params.vcfFreq, 10.0f, JunoFastMath::kLog2VCFRange);
+    
+    // Master tune (±50 cents)
+    float tuneSemitones = params.tune / 100.0f;
+    
+    float* voiceData = scratch[AudioLane].data();
+    float* envData = scratch[EnvLane].data();
+    float* lfoData = scratch[LFOLane].data();
+    float* pitchData = scratch[PitchLane].data();
+    float* cutoffData = scratch[CutoffLane].data();
+    
+    // Noise source: the shared block, or this voice's own generator
+    const float* noiseData = nullptr;
+    if (params.noiseLevel > 0.0f) {
+        if (sharedNoise != nullptr) {
+            noiseData = sharedNoise + startSample;
+        } else {
+            noise.fill(scratch[NoiseLane].data(), numSamples);
+            noiseData = scratch[NoiseLane].data();
+        }
+    }
+    
+    // Audio-rate envelope: rendered for the whole sub-block up front
+    if (hot.controlTickSamples == 0) {
+        adsr.processBlock(envData, numSamples);
     }
-
-    // Temporary buffers
-    juce::AudioBuffer<float> voiceBuffer(1, numSamples);
-    voiceBuffer.clear();
     
-    // Generate oscillator and modulation
+    // 1. Control pass: LFO, ADSR, glide and pitch per sample (block-size
+    //    independent); VCF cutoff every controlInterval samples on a phase
+    //    that runs across blocks
+    int phase = hot.controlPhase;
     for (int i = 0; i < numSamples; ++i) {
-        // 1. Advance LFO (Per-sample is mandatory for timing)
-        float lfoValue = lfo.getNextSample();
+        if (hot.controlTickSamples > 0) {
+            if (hot.tickCountdown == 0) {
+                // CPU tick: evaluate ADSR/LFO and ramp to the new values over one tick
+                const float invTick = 1.0f / static_cast<float>(hot.controlTickSamples);
+                hot.envTarget = adsr.getNextSample();
+                hot.lfoTarget = lfo.getNextSample();
+                hot.envStep = (hot.envTarget - hot.envValue) * invTick;
+                hot.lfoStep = (hot.lfoTarget - hot.lfoValue) * invTick;
+                hot.tickCountdown = hot.controlTickSamples;
+            }
+            if (--hot.tickCountdown == 0) {
+                hot.envValue = hot.envTarget;
+                hot.lfoValue = hot.lfoTarget;
+            } else {
+                hot.envValue += hot.envStep;
+                hot.lfoValue += hot.lfoStep;
+            }
+            envData[i] = hot.envValue;
+        } else {
+            hot.envValue = envData[i];
+            hot.lfoValue = lfo.getNextSample();
+        }
+        lfoData[i] = hot.lfoValue;
         
-        // 2. Update VCF Cutoff (Frequent update for snap)
-        if ((i % 8) == 0) {
-            float envVal = adsr.getCurrentValue();
-            
-            float envModOctaves = envVal * params.envAmount * 14.0f;
+        float bend = benderLane != nullptr ? benderLane[i >> hot.laneShift] : params.benderValue;
+        float modWheel = modWheelLane != nullptr ? modWheelLane[i >> hot.laneShift] : 0.0f;
+        
+        if (hot.glideSemitones != 0.0f) {
+            hot.glideSemitones -= hot.glideSemitones * hot.glideCoeff;
+            if (std::abs(hot.glideSemitones) < 0.0005f) hot.glideSemitones = 0.0f;
+        }
+        
+        // VCF Cutoff at the control tick
+        if (phase == 0) {
+            float envModOctaves = hot.envValue * params.envAmount * 14.0f;
             if (params.vcfPolarity == 1) envModOctaves = -envModOctaves;
             
-            float lfoModOctaves = lfoValue * params.vcfLFOAmount * 3.5f;
-            float benderModOctaves = params.benderValue * params.benderToVCF * 3.5f;
+            // Modulation lever adds LFO depth (Authentic feel)
+            float lfoModOctaves = hot.lfoValue * juce::jlimit(0.0f, 1.0f, params.vcfLFOAmount + modWheel) * 3.5f;
+            float benderModOctaves = bend * params.benderToVCF * 3.5f;
             
-            float modulatedCutoff = baseCutoff * std::pow(2.0f, envModOctaves + lfoModOctaves + benderModOctaves);
-            modulatedCutoff = juce::jlimit(5.0f, static_cast<float>(sampleRate * 0.45), modulatedCutoff * variance.filterCutoffScale);
-            filter.setCutoffFrequencyHz(modulatedCutoff);
+            // Keyboard tracking follows the gliding pitch
+            float kybdOctaves = 0.0f;
+            if (params.kybdTracking > 0.0f) {
+                float semitones = static_cast<float>(hot.currentNote) + hot.glideSemitones - 60.0f;
+                kybdOctaves = (semitones * params.kybdTracking) / 12.0f;
+            }
+            
+            float modulatedCutoff = baseCutoff * JunoFastMath::octavesToRatio(envModOctaves + lfoModOctaves + benderModOctaves + kybdOctaves);
+            cutoffData[i] = juce::jlimit(5.0f, static_cast<float>(sampleRate * 0.45), modulatedCutoff * variance.filterCutoffScale);
         }
+        if (++phase == hot.controlInterval) phase = 0;
         
-        // 3. Generate sample from JunoDCO
-        float sample = dco.getNextSample(lfoValue);
-        
-        // 4. Apply HPF
-        sample = hpFilter.processSample(sample);
-        
-        voiceBuffer.setSample(0, i, sample);
+        // DCO pitch modulation (vibrato ~ half semitone max, bender +/- 1 octave)
+        float lfoToDCO = juce::jlimit(0.0f, 1.0f, params.lfoToDCO + modWheel);
+        pitchData[i] = hot.glideSemitones + tuneSemitones
+                     + hot.lfoValue * lfoToDCO * 0.5f
+                     + bend * params.benderToDCO * 12.0f;
     }
     
-    // Process filter on entire block
-    juce::dsp::AudioBlock<float> block(voiceBuffer);
-    juce::dsp::ProcessContextReplacing<float> context(block);
-    filter.process(context);
+    // 2. Pitch to frequency ratio for the whole block (vectorised)
+    JunoFastMath::semitonesToRatio(pitchData, pitchData, numSamples);
     
-    // Apply VCA envelope and mix to output
-    for (int i = 0; i < numSamples; ++i) {
-        float sample = voiceBuffer.getSample(0, i);
-        float envelope = adsr.getNextSample();
+    // 3. Audio pass, one control segment at a time
+    int pos = 0;
+    while (pos < numSamples) {
+        const int segmentLength = juce::jmin(hot.controlInterval - hot.controlPhase, numSamples - pos);
+        
+        if (hot.controlPhase == 0) {
+            filter.setCutoffFrequencyHz(cutoffData[pos]);
+        }
         
-        if (params.vcaMode == 1) { // GATE (handled by adsr internal mode)
-            sample *= envelope * velocity; 
-        } else { // ENV
-            sample *= envelope * velocity;
+        for (int i = pos; i < pos + segmentLength; ++i) {
+            // Generate sample from JunoDCO, then HPF
+            float sample = dco.getNextSample(lfoData[i], pitchData[i], noiseData != nullptr ? noiseData[i] : 0.0f);
+            voiceData[i] = hot.hpf.process(sample);
         }
         
-        sample *= params.vcaLevel;
+        // VCF over this control segment
+        filter.process(voiceData + pos, segmentLength);
         
-        buffer.addSample(0, startSample + i, sample);
-        if (buffer.getNumChannels() > 1) {
-            buffer.addSample(1, startSample + i, sample);
+        hot.controlPhase = (hot.controlPhase + segmentLength) % hot.controlInterval;
+        pos += segmentLength;
+    }
+    
+    // Apply VCA envelope (GATE is handled by the ADSR's internal mode), vectorised
+    const float gain = hot.velocity * params.vcaLevel;
+    juce::FloatVectorOperations::multiply(voiceData, envData, numSamples);
+    if (hot.tailFadeStep > 0.0f) {
+        // Anti-click fade of a retiring voice
+        for (int i = 0; i < numSamples; ++i) {
+            hot.tailFadeGain = juce::jmax(0.0f, hot.tailFadeGain - hot.tailFadeStep);
+            voiceData[i] *= gain * hot.tailFadeGain;
         }
+    } else {
+        juce::FloatVectorOperations::multiply(voiceData, gain, numSamples);
     }
+    
+    const auto range = juce::FloatVectorOperations::findMinAndMax(voiceData, numSamples);
+    
+    // Mix into the mono voice bus (stereo is expanded once, after the voices)
+    juce::FloatVectorOperations::add(buffer.getWritePointer(0, startSample), voiceData, numSamples);
+    
+    return juce::jmax(-range.getStart(), range.getEnd());
 }
@@ -1,24 +1,38 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <array>
+#include <type_traits>
 #include "../Core/SynthParams.h"
 #include "JunoDCO.h"
 #include "JunoLFO.h"
 #include "JunoADSR.h"
+#include "JunoModulationBus.h"
+#include "JunoNoise.h"
+#include "JunoVCF.h"
 
 /**
  * Voice - Single voice for SimpleJuno106
  * 
  * Uses JUCE built-in components + Juno-106 authentic modules:
  * - JunoDCO for oscillator (RANGE, PWM modes, Noise, authentic)
- * - juce::dsp::LadderFilter for VCF
+ * - JunoVCF for VCF (IR3109 ladder, anti-aliased drive)
  * - JunoVCO for oscillator (with drift)
  * - JunoLFO for modulation (with delay)
+ * 
+ * Layout: the per-sample state of the voice is one aligned plain-data block
+ * (HotState), the sub-block scratch is inline, and no member owns heap
+ * memory or a ref-counted pointer; configuration follows as cold data
  */
 class Voice {
 public:
     Voice();
     
+    // Internal processing size (voice-rate samples): every stage runs over one
+    // sub-block before the next starts, so the scratch stays in L1. The
+    // processor's post-voice chain uses the same size (single definition)
+    static constexpr int kSubBlockSize = 64;
+    
     // Analog Variance (Mojo)
     struct Variance {
         float filterCutoffScale = 1.0f; // +/- 5%
@@ -28,26 +42,98 @@ public:
     };
     
     void setVariance(const Variance& v) { variance = v; }
+    void setModulationBus(const JunoModulationBus* bus) { modBus = bus; }
+    void setNoiseSource(const float* noiseBuffer) { sharedNoise = noiseBuffer; }
+    void setRandomSeed(uint32_t seed) { noise.setSeed(seed); }
+    void setOversamplingFactor(int factor);
+    void setDriftRatio(float ratio) { dco.setDriftRatio(ratio); }
     void prepare(double sampleRate, int maxBlockSize);
+    
+    // Rate change while playing (oversampling switch): only the rate-dependent
+    // coefficients are recomputed; phases, filter state and LFO note state stay
+    void setSampleRate(double sampleRate);
     void noteOn(int midiNote, float velocity);
     void noteOff();
     
+    // Adds the voice to channel 0 of buffer (the mono voice bus)
     void renderNextBlock(juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
     
     void updateParams(const SynthParams& params);
     
     bool isActive() const { return adsr.isActive(); }
-    int getCurrentNote() const { return currentNote; }
+    bool isReleasing() const { return adsr.getCurrentStage() == JunoADSR::Stage::Release; }
+    
+    // Silent-tail culling: a releasing voice whose output peak (after VCF and
+    // VCA) falls below the floor fades out and goes idle. 0 = off
+    void setTailFloor(float gain) { hot.tailFloor = gain; }
+    bool isRetiring() const { return hot.tailFadeStep > 0.0f; }
+    float getOutputPeak() const { return hot.outputPeak; }
+    int getCurrentNote() const { return hot.currentNote; }
     
 private:
-    // State
-    double sampleRate = 44100.0;
-    int currentNote = -1;
-    float velocity = 0.0f;
+    // Control rate for the VCF (samples at 1x)
+    static constexpr int kControlInterval = 8;
+    
+    // Silent-tail culling (anti-click fade before going idle)
+    static constexpr float kTailFadeSeconds = 0.002f;
+    
+    // Juno-106 HPF: 2nd-order highpass, transposed direct form II
+    struct HighPass {
+        float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f;
+        float z1 = 0.0f, z2 = 0.0f;
+        
+        void reset() { z1 = z2 = 0.0f; }
+        float process(float x) {
+            const float y = b0 * x + z1;
+            z1 = b1 * x - a1 * y + z2;
+            z2 = b2 * x - a2 * y;
+            return y;
+        }
+    };
     
-    // Portamento
-    float currentFrequency = 440.0f;
-    float targetFrequency = 440.0f;
+    // Hot state: everything the per-sample loops of the voice itself touch,
+    // pointer-free and cache-line aligned, at the front of the object
+    struct alignas(64) HotState {
+        // Note
+        int currentNote = -1;
+        float velocity = 0.0f;
+        
+        // Portamento: offset from the current note (semitones), decays to 0
+        float glideSemitones = 0.0f;
+        float glideCoeff = 1.0f;        // Per-sample decay (1 = no glide)
+        
+        // VCF control interval, phase persists across blocks
+        int controlInterval = kControlInterval;
+        int controlPhase = 0;
+        
+        // Oversampling: the voice runs at factor x the host rate; controller
+        // lanes stay at the host rate (index >> laneShift)
+        int laneShift = 0;
+        
+        // Optional control-rate engine: ADSR/LFO are evaluated once per tick (like
+        // the Juno's CPU) and linearly interpolated to audio rate. 0 = audio rate
+        int controlTickSamples = 0;
+        int tickCountdown = 0;
+        float envValue = 0.0f, envTarget = 0.0f, envStep = 0.0f;
+        float lfoValue = 0.0f, lfoTarget = 0.0f, lfoStep = 0.0f;
+        
+        // Silent-tail culling
+        float tailFloor = 0.0f;
+        float tailFadeGain = 1.0f;
+        float tailFadeStep = 0.0f;     // > 0 while retiring
+        float outputPeak = 0.0f;       // Peak of the last rendered block
+        
+        HighPass hpf;
+    };
+    static_assert(std::is_trivially_copyable_v<HotState> && std::is_standard_layout_v<HotState>,
+                  "Voice hot state must stay plain data");
+    static_assert(sizeof(HotState) <= 128, "Voice hot state should fit two cache lines");
+    
+    HotState hot;
+    
+    // Scratch, one sub-block per lane (inline, no allocation)
+    enum ScratchLane { AudioLane, EnvLane, NoiseLane, LFOLane, PitchLane, CutoffLane, NumScratchLanes };
+    alignas(64) std::array<std::array<float, kSubBlockSize>, NumScratchLanes> scratch {};
     
     // Juno modules
     JunoDCO dco;
@@ -56,15 +142,31 @@ private:
     // Juno ADSR (linear ramps, authentic)
     JunoADSR adsr;
     
-    // JUCE Ladder Filter
-    juce::dsp::LadderFilter<float> filter;
-    juce::dsp::IIR::Filter<float> hpFilter;  // Juno-106 HPF
+    // IR3109 ladder (ADAA drive)
+    JunoVCF filter;
+    
+    //==============================================================================
+    // Cold configuration (block rate and note-on only)
+    double sampleRate = 44100.0;
+    float noteFrequency = 440.0f;
     
     // Cached params
     SynthParams params;
     
+    // Shared performance controllers (owned by the processor)
+    const JunoModulationBus* modBus = nullptr;
+    
+    // Shared noise block (owned by the manager); own source when not connected
+    const float* sharedNoise = nullptr;
+    JunoNoise noise;
+    
     // Helper methods
     void updateHPF();
+    void updateControlRate(bool force = false);
+    float renderSubBlock(juce::AudioBuffer<float>& buffer, int startSample, int numSamples); // Returns the peak
     
     Variance variance;
 };
+
+// Per-voice footprint budget (every voice of every instance pays it)
+static_assert(sizeof(Voice) <= 4096, "Voice should stay within one page");
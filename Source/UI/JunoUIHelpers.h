@@ -27,16 +27,22 @@ namespace JunoUI
             {
                 juce::PopupMenu menu;
                 
-                int currentCC = handler.getCCForParam(paramID);
-                juce::String ccText = (currentCC >= 0) ? " (Mapped to CC " + juce::String(currentCC) + ")" : " (Unmapped)";
+                juce::String mapping = handler.getMappingDescription(paramID);
+                juce::String ccText = mapping.isNotEmpty() ? " (Mapped to " + mapping + ")" : " (Unmapped)";
                 
                 menu.addItem(1, "MIDI Learn" + ccText);
-                menu.addItem(2, "Clear MIDI Mapping", currentCC >= 0);
+                menu.addItem(3, "MIDI Learn 14-bit (CC 0-31 + LSB / NRPN)");
+                menu.addItem(2, "Clear MIDI Mapping", mapping.isNotEmpty());
 
                 menu.showMenuAsync(juce::PopupMenu::Options(), [this](int result)
                 {
+                    handler.onMappingRejected = [](const juce::String& reason) {
+                        juce::AlertWindow::showMessageBoxAsync(juce::MessageBoxIconType::WarningIcon, "MIDI Learn", reason);
+                    };
+                    
                     if (result == 1) handler.startLearning(paramID);
-                    else if (result == 2) handler.bind(-1, paramID); // Unbind
+                    else if (result == 3) handler.startLearning(paramID, true);
+                    else if (result == 2) handler.unbindParam(paramID);
                 });
             }
         }
@@ -162,6 +162,7 @@ public:
         };
 
         addAndMakeVisible(lcd);
+        JunoUI::setupLabel(cpuLabel, "CPU FULL", *this);
         startTimer(50); // 20Hz update for LCD
     }
 
@@ -185,6 +186,9 @@ public:
                 int prog = (patchIdx % 8) + 1;
                 lcd.setText(juce::String(bankIdx) + "-" + juce::String(group) + juce::String(prog));
             }
+            
+            // Quality tier chosen by the CPU governor
+            cpuLabel.setText(juce::String("CPU ") + JunoCpuGovernor::getTierName(proc->getCpuGovernor().getTier()), juce::dontSendNotification);
         }
     }
     
@@ -219,6 +223,7 @@ public:
 
         // LCD placement
         lcd.setBounds(x, 10, 80, 40);
+        cpuLabel.setBounds(x - 10, 55, 100, 20);
         x += 90;
         
         // Presets
@@ -263,7 +268,7 @@ public:
 private:
     JunoBender bender;
     juce::Slider portSlider;
-    juce::Label portLabel, modeLabel;
+    juce::Label portLabel, modeLabel, cpuLabel;
     juce::ToggleButton portButton;
     juce::ComboBox modeCombo;
     